@@ -11,9 +11,11 @@ namespace ux {}
 #include "ux/Assets.hpp"
 #include "ux/Button.hpp"
 #include "ux/Component.hpp"
+#include "ux/Compositor.hpp"
 #include "ux/Controller.hpp"
 #include "ux/Event.hpp"
 #include "ux/EventLoop.hpp"
+#include "ux/FramebufferDisplayDevice.hpp"
 #include "ux/Graph.hpp"
 #include "ux/Label.hpp"
 #include "ux/Layout.hpp"
@@ -22,11 +24,14 @@ namespace ux {}
 #include "ux/Progress.hpp"
 #include "ux/ProgressBar.hpp"
 #include "ux/Separator.hpp"
+#include "ux/SimulatedDisplayDevice.hpp"
 #include "ux/Slider.hpp"
 #include "ux/TextArea.hpp"
+#include "ux/TextBuffer.hpp"
 #include "ux/TextFileArea.hpp"
 #include "ux/ToggleSwitch.hpp"
 #include "ux/TouchGesture.hpp"
+#include "ux/VirtualList.hpp"
 
 using namespace ux;
 
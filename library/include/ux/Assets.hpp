@@ -3,6 +3,10 @@
 #ifndef SAPI_SYS_ASSETS_HPP_
 #define SAPI_SYS_ASSETS_HPP_
 
+#include <fs/ViewFile.hpp>
+
+#include "fmt/AssetPack.hpp"
+#include "sgfx/Bitmap.hpp"
 #include "sgfx/Font.hpp"
 #include "sgfx/IconFont.hpp"
 #include "sgfx/Vector.hpp"
@@ -14,13 +18,33 @@ public:
   template <class FontType> class Asset {
     API_AC(Asset<FontType>, sgfx::Font::Info, info);
     API_AC(Asset<FontType>, FontType, font);
+    API_AC(Asset<FontType>, var::View, data);
     fs::File m_file;
+    fs::ViewFile m_data_file;
+
+    static void
+    create_font(const var::View data, fs::ViewFile &, sgfx::Font &font) {
+      font = sgfx::Font(data);
+    }
+
+    static void create_font(
+      const var::View data,
+      fs::ViewFile &data_file,
+      sgfx::IconFont &font) {
+      data_file = fs::ViewFile(data);
+      font = sgfx::IconFont(&data_file);
+    }
 
   public:
     const Asset<FontType> *create() {
       if (m_font.is_valid() == false) {
-        m_file = fs::File(m_info.file_path());
-        m_font = FontType(&m_file);
+        if (m_data.size() > 0) {
+          // assets in a pack are used in place
+          create_font(m_data, m_data_file, m_font);
+        } else {
+          m_file = fs::File(m_info.file_path());
+          m_font = FontType(&m_file);
+        }
       }
       return this;
     }
@@ -46,6 +70,17 @@ public:
 
   static void initialize();
 
+  /*! \details Loads the fonts, icon fonts, bitmaps, and vector icons
+   * in the asset pack at \a path (see fmt::AssetPack).
+   *
+   * If the pack is loaded before the assets are first used, the
+   * asset directories are not searched. A pack cannot be loaded
+   * once a font or icon font has been created because the fonts
+   * are referred to by address (for example, by draw::Text).
+   */
+  static void load_pack(const var::StringView path);
+  static const fmt::AssetPack &pack() { return m_pack; }
+
   class FindFont {
     API_AC(FindFont, var::StringView, name);
     API_AF(FindFont, u16, point_size, 0);
@@ -53,11 +88,26 @@ public:
     API_AB(FindFont, exact_match, false);
   };
 
+  /*! \details Returns the font that best matches \a options.
+   *
+   * The most recent results are remembered, so drawings that resolve
+   * their fonts each time they are drawn do not search the font list.
+   */
   static const FontAsset *find_font(const FindFont &options);
 
   using FindIconFont = FindFont;
   static const IconFontAsset *find_icon_font(const FindIconFont &options);
 
+  /*! \details Returns the bitmap named \a name in the asset pack.
+   * The bitmap is used in place.
+   */
+  static sgfx::MappedBitmap find_bitmap(const var::StringView name);
+
+  /*! \details Returns the vector icon named \a name in the asset
+   * pack. The path descriptions are used in place.
+   */
+  static sgfx::VectorPath find_vector_icon(const var::StringView name);
+
   static void find_fonts_in_directory(const var::StringView path);
   static void find_icons_in_directory(const var::StringView path);
 #if 0
@@ -77,6 +127,34 @@ private:
   static bool m_is_initialized;
   static var::Vector<FontAsset> m_font_info_list;
   static var::Vector<IconFontAsset> m_icon_font_info_list;
+  static fmt::AssetPack m_pack;
+  static u32 m_pack_font_offset;
+  static u32 m_pack_icon_font_offset;
+
+  struct FindResult {
+    u32 name_hash;
+    u16 point_size;
+    u8 style;
+    u8 flags;
+    void *asset;
+  };
+
+  enum find_result_flags {
+    find_result_flag_icon_font = 0x01,
+    find_result_flag_exact_match = 0x02
+  };
+
+  static constexpr size_t find_result_count = 8;
+  static FindResult m_find_result_list[find_result_count];
+  static u32 m_find_result_next;
+
+  static void *get_find_result(u8 flags, const FindFont &options);
+  static void set_find_result(u8 flags, const FindFont &options, void *asset);
+  static void clear_find_results();
+  static const FontAsset *find_font_in_list(const FindFont &options);
+  static const IconFontAsset *
+  find_icon_font_in_list(const FindIconFont &options);
+  static FindResult create_find_result(u8 flags, const FindFont &options);
   //  static var::Vector<fmt::Svic> m_vector_path_list;
 
   static var::Vector<FontAsset> &font_info_list() {
@@ -88,6 +166,21 @@ private:
     initialize();
     return m_icon_font_info_list;
   }
+
+  template <class FontType>
+  static void load_pack_fonts(
+    fmt::AssetPack::Type type,
+    var::Vector<Asset<FontType>> &list);
+
+  template <class AssetType>
+  static bool is_any_created(const var::Vector<AssetType> &list);
+
+  template <class AssetType>
+  static AssetType *find_pack_font(
+    var::Vector<AssetType> &list,
+    u32 list_offset,
+    fmt::AssetPack::Type type,
+    const FindFont &options);
 };
 
 } // namespace ux
@@ -113,8 +113,22 @@ public:
 
   void erase();
 
+  /*! \details Forces the next refresh to write to the display. Refreshes
+   * are skipped when the component's pixels have not changed since
+   * the last write. Call this if the display was changed by something
+   * other than this component.
+   */
+  virtual void invalidate_refresh() { m_refresh_hash = 0; }
+
   void set_refresh_drawing_pending();
 
+  /*! \details Marks only \a region of the component (in local
+   * bitmap coordinates) as changed. The next refresh writes just that
+   * part of the component to the display. If the whole component is
+   * already pending, it is still written in full.
+   */
+  void set_refresh_drawing_pending(const sgfx::Region &region);
+
   static EventLoop *event_loop() { return m_event_loop; }
 
   Layout *parent() { return m_parent; }
@@ -255,6 +269,10 @@ private:
   sgfx::Theme::Style m_theme_style = sgfx::Theme::Style::brand_primary;
   sgfx::Theme::State m_theme_state = sgfx::Theme::State::default_;
   sgfx::Region m_refresh_region;
+  // the part of the component to write (empty for all of it)
+  sgfx::Region m_damage_region;
+  // hash of the pixels and window last written to the display
+  u64 m_refresh_hash = 0;
   Layout *m_parent = nullptr;
   u32 m_flags;
 
@@ -0,0 +1,195 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#ifndef UXAPI_UX_COMPOSITOR_HPP_
+#define UXAPI_UX_COMPOSITOR_HPP_
+
+#include <var/Vector.hpp>
+
+#include "sgfx/Bitmap.hpp"
+#include "sgfx/Palette.hpp"
+
+namespace ux {
+
+/*! \brief Compositor Class
+ * \details A compositor keeps a copy of the display pixels so that
+ * writes made during a frame can be collected and sent to the
+ * display together when the frame ends (see Display::set_compositor()).
+ *
+ * Each write is copied to bitmap() and its window is added to the
+ * damage list. Each damaged region is merged with the others as it is
+ * added whenever sending their bounds costs less than sending them
+ * separately. The cost of a window is transaction_cost() plus the
+ * number of bytes in the window.
+ *
+ * When a window that is already on the display is written again,
+ * only the regions that changed (see sgfx::BitmapDiff) are added
+ * to the damage list.
+ *
+ * Palettes set during a frame (see set_palette()) are kept with the
+ * damage. Each region is sent after the palette that was set when it
+ * was written, and regions with different palettes are not merged.
+ *
+ * \code
+ * Compositor compositor(display.bitmap().area(),
+ *   display.bitmap().bits_per_pixel());
+ * display.set_compositor(&compositor);
+ * // Controller draws each event as one frame
+ * \endcode
+ *
+ */
+class Compositor {
+public:
+  /*! \brief A damaged region and the palette it is sent with */
+  class Damage {
+    API_AC(Damage, sgfx::Region, region);
+    // zero for the palette the device had when the frame started,
+    // otherwise palette_list().at(palette() - 1)
+    API_AF(Damage, u16, palette, 0);
+  };
+
+  Compositor(
+    const sgfx::Area &area,
+    sgfx::Bitmap::BitsPerPixel bits_per_pixel);
+
+  const sgfx::Bitmap &bitmap() const { return m_bitmap; }
+  const sgfx::Region &window() const { return m_window; }
+
+  Compositor &set_window(const sgfx::Region &region) {
+    m_window = region;
+    return *this;
+  }
+
+  /*! \details Copies the window-sized part of \a bitmap that starts
+   * at the bitmap offset to the current window and adds the window
+   * to the damage list.
+   */
+  Compositor &write_bitmap(const sgfx::Bitmap &bitmap);
+
+  /*! \details Clears the current window and adds it to the damage
+   * list.
+   */
+  Compositor &clear();
+
+  Compositor &add_damage(const sgfx::Region &region);
+
+  /*! \details Sets the palette that the following writes are sent
+   * with. It is ignored if it matches the palette already in effect
+   * (including one from an earlier frame). Otherwise, during a frame,
+   * the palette is kept until clear_damage() so it reaches the device
+   * after the writes that were made before it.
+   */
+  Compositor &set_palette(const sgfx::Palette &palette);
+
+  /*! \details Forgets the palette in effect and which windows are on
+   * the display so the next palette and writes are sent in full. Use
+   * this if something other than the compositor changes the display.
+   */
+  Compositor &invalidate() {
+    m_is_palette_valid = false;
+    m_written_list.clear();
+    return *this;
+  }
+
+  /*! \details Returns the palettes set during the frame in the order
+   * they were set.
+   */
+  const var::Vector<sgfx::Palette> &palette_list() const {
+    return m_palette_list;
+  }
+
+  /*! \details Returns true if there are damaged regions or palettes
+   * to send to the display.
+   */
+  bool is_damaged() const {
+    return (m_damage_list.count() > 0) || (m_palette_list.count() > 0);
+  }
+
+  /*! \details Returns the damaged regions. They are merged as they
+   * are added and kept until clear_damage() is called.
+   */
+  const var::Vector<Damage> &damage_list() const { return m_damage_list; }
+
+  Compositor &clear_damage() {
+    m_window_count += m_damage_list.count();
+    m_damage_list.clear();
+    m_palette_list.clear();
+    return *this;
+  }
+
+  Compositor &begin_frame() {
+    m_frame_depth++;
+    return *this;
+  }
+
+  /*! \details Ends a frame and returns true if it was the outermost
+   * frame (the damage should be sent to the display).
+   */
+  bool end_frame() {
+    if (m_frame_depth) {
+      m_frame_depth--;
+    }
+    return m_frame_depth == 0;
+  }
+
+  bool is_frame() const { return m_frame_depth > 0; }
+
+  u32 calculate_cost(const sgfx::Region &region) const;
+
+  /*! \details Returns the number of regions added to the damage
+   * list.
+   */
+  u32 damage_count() const { return m_damage_count; }
+
+  /*! \details Returns the number of merged windows that were
+   * cleared from the damage list.
+   */
+  u32 window_count() const { return m_window_count; }
+
+  void reset_statistics() {
+    m_damage_count = 0;
+    m_window_count = 0;
+  }
+
+  /*! \details Sets the cost of sending a window to the display in
+   * bytes. It accounts for the request and the window command on the
+   * display bus.
+   */
+  API_AF(Compositor, u32, transaction_cost, 128);
+
+  /*! \details Compares writes to windows that are already on the
+   * display with bitmap() so only the changed regions are damaged.
+   */
+  API_AB(Compositor, diff, true);
+
+private:
+  static constexpr size_t maximum_written_count = 16;
+
+  struct Written {
+    sgfx::Region region;
+    u32 palette_revision;
+  };
+
+  sgfx::BitmapData m_bitmap;
+  sgfx::Region m_window;
+  var::Vector<Damage> m_damage_list;
+  var::Vector<sgfx::Palette> m_palette_list;
+  // the palette the following writes are sent with
+  sgfx::Palette m_palette;
+  bool m_is_palette_valid = false;
+  // changes with each new palette so windows are written again with it
+  u32 m_palette_revision = 0;
+  // windows where bitmap() matches what is sent to the display
+  var::Vector<Written> m_written_list;
+  sgfx::BitmapData m_previous;
+  sgfx::BitmapData m_current;
+  u32 m_frame_depth = 0;
+  u32 m_damage_count = 0;
+  u32 m_window_count = 0;
+
+  bool is_written(const sgfx::Region &region) const;
+  void add_written(const sgfx::Region &region);
+};
+
+} // namespace ux
+
+#endif // UXAPI_UX_COMPOSITOR_HPP_
@@ -3,18 +3,30 @@
 #ifndef UXAPI_UX_DISPLAY_HPP_
 #define UXAPI_UX_DISPLAY_HPP_
 
-#include <sdk/types.h>
-#include <sos/dev/display.h>
-
 #include <var/View.hpp>
 #include <var/StringView.hpp>
 
-#include "sgfx/Bitmap.hpp"
+#include "Compositor.hpp"
+#include "DisplayDevice.hpp"
 
 namespace ux {
 
-class Display : public fs::FileMemberAccess<Display, fs::File>,
-                public api::ExecutionContext {
+/*! \brief Display Class
+ * \details The display sends the bitmaps drawn by components to a
+ * DisplayDevice. Constructing a display with a path uses a
+ * FileDisplayDevice. Other devices (such as a
+ * FramebufferDisplayDevice or a SimulatedDisplayDevice) run the
+ * same drawing pipeline without display hardware.
+ *
+ * \code
+ * SimulatedDisplayDevice device(SimulatedDisplayDevice::Construct()
+ *                                 .set_area(sgfx::Area(240, 240))
+ *                                 .set_bus_frequency(20000000));
+ * Display display(device);
+ * \endcode
+ *
+ */
+class Display : public api::ExecutionContext {
 public:
   enum class Mode { palette, raw };
   using BitsPerPixel = sgfx::Bitmap::BitsPerPixel;
@@ -53,6 +65,33 @@ public:
   };
 
   Display(var::StringView path);
+  explicit Display(DisplayDevice &device);
+
+  Display(const Display &a) = delete;
+  Display &operator=(const Display &a) = delete;
+
+  DisplayDevice &device() { return *m_device; }
+  const DisplayDevice &device() const { return *m_device; }
+
+  /*! \details Sends windows and writes through \a value (nullptr to
+   * stop using a compositor). The area and bits per pixel of the
+   * compositor must match bitmap().
+   *
+   * Writes and palettes set between begin_frame() and end_frame()
+   * are sent to the device when the frame ends, in the order they
+   * were made; writes are merged unless their palettes differ. Writes
+   * made outside a frame are sent right away.
+   */
+  Display &set_compositor(Compositor *value) {
+    m_compositor = value;
+    return *this;
+  }
+
+  Compositor *compositor() { return m_compositor; }
+  const Compositor *compositor() const { return m_compositor; }
+
+  const Display &begin_frame() const;
+  const Display &end_frame() const;
 
   Display::Info get_info() const;
 
@@ -75,10 +114,59 @@ public:
   const Display &set_palette(const sgfx::Palette &palette) const;
   sgfx::Palette get_palette() const;
 
-protected:
+  /*! \details Forgets the window, mode, and palette that were sent
+   * to the device so the next requests are sent even if they match
+   * (see also Compositor::invalidate()). Use this if something other
+   * than this object changes the device.
+   */
+  const Display &invalidate_state() const {
+    m_state.is_window_valid = false;
+    m_state.is_palette_valid = false;
+    m_state.mode_flags = 0;
+    if (m_compositor) {
+      m_compositor->invalidate();
+    }
+    return *this;
+  }
+
+  /*! \details Returns the number of set_window() requests that were
+   * not sent to the device because the window was already set.
+   */
+  u32 skipped_window_count() const { return m_state.skipped_window_count; }
+  u32 skipped_mode_count() const { return m_state.skipped_mode_count; }
+  u32 skipped_palette_count() const { return m_state.skipped_palette_count; }
+
+  void reset_statistics() {
+    m_state.skipped_window_count = 0;
+    m_state.skipped_mode_count = 0;
+    m_state.skipped_palette_count = 0;
+  }
 
 private:
   API_AC(Display, sgfx::Bitmap, bitmap);
+  FileDisplayDevice m_file_device;
+  DisplayDevice *m_device;
+  Compositor *m_compositor = nullptr;
+
+  // the state that was last sent to the device
+  struct State {
+    sgfx::Region window;
+    bool is_window_valid = false;
+    u32 mode_flags = 0;
+    bool is_palette_valid = false;
+    u8 palette_pixel_format = 0;
+    var::Vector<sg_color_t> palette_colors;
+    u32 skipped_window_count = 0;
+    u32 skipped_mode_count = 0;
+    u32 skipped_palette_count = 0;
+  };
+
+  mutable State m_state;
+
+  void initialize();
+  void flush() const;
+  void set_device_window(const sgfx::Region &region) const;
+  void set_device_palette(const sgfx::Palette &palette) const;
 };
 
 } // namespace ux
@@ -1,24 +1,101 @@
-/*! \file */ // Copyright 2011-2020 Tyler Gilbert and Stratify Labs, Inc; see
-             // LICENSE.md for rights.
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
 
 #ifndef UXAPI_UX_DISPLAYDEVICE_HPP_
 #define UXAPI_UX_DISPLAYDEVICE_HPP_
 
+#include <sdk/types.h>
+#include <sos/dev/display.h>
+
 #include <fs/File.hpp>
 
-#include "Display.hpp"
+#include "sgfx/Bitmap.hpp"
 
 namespace ux {
 
-class DisplayDevice : public fs::FileAccess<DisplayFile> {
+/*! \brief Display Device Class
+ * \details A display device is the backend that Display sends
+ * requests to. The requests mirror the display driver interface
+ * (`sos/dev/display.h`) so a backend can be a device file, memory,
+ * or a simulated panel.
+ *
+ * \code
+ * FileDisplayDevice device("/dev/display0");
+ * Display display(device);
+ * \endcode
+ *
+ */
+class DisplayDevice : public api::ExecutionContext {
 public:
-  DisplayDevice();
-  DisplayDevice::DisplayDevice(const var::StringView  path);
+  virtual ~DisplayDevice() {}
+
+  display_info_t get_info() const { return interface_get_info(); }
+
+  /*! \details Applies \a attributes. `DISPLAY_FLAG_ENABLE`,
+   * `DISPLAY_FLAG_CLEAR` and `DISPLAY_FLAG_DISABLE` apply to the
+   * current window.
+   */
+  DisplayDevice &set_attributes(const display_attr_t &attributes) {
+    interface_set_attributes(attributes);
+    return *this;
+  }
+
+  /*! \details Writes the window-sized part of \a bitmap that starts
+   * at the bitmap offset (see Bitmap::set_offset()) to the current
+   * window.
+   */
+  DisplayDevice &write_bitmap(const sgfx::Bitmap &bitmap) {
+    interface_write_bitmap(bitmap);
+    return *this;
+  }
+
+  DisplayDevice &refresh() {
+    interface_refresh();
+    return *this;
+  }
+
+  bool is_busy() const { return interface_is_busy(); }
+
+  DisplayDevice &set_palette(const display_palette_t &palette) {
+    interface_set_palette(palette);
+    return *this;
+  }
+
+  display_palette_t get_palette() const { return interface_get_palette(); }
 
 protected:
-  fs::File m_device;
+  virtual display_info_t interface_get_info() const = 0;
+  virtual void interface_set_attributes(const display_attr_t &attributes) = 0;
+  virtual void interface_write_bitmap(const sgfx::Bitmap &bitmap) = 0;
+  virtual void interface_refresh() = 0;
+  virtual bool interface_is_busy() const = 0;
+  virtual void interface_set_palette(const display_palette_t &palette) = 0;
+  virtual display_palette_t interface_get_palette() const = 0;
+};
+
+/*! \brief File Display Device Class
+ * \details This class sends display requests to a device file using
+ * the `I_DISPLAY_*` ioctl requests.
+ */
+class FileDisplayDevice : public DisplayDevice {
+public:
+  FileDisplayDevice() {}
+  explicit FileDisplayDevice(const var::StringView path);
+
+  const fs::File &file() const { return m_file; }
+
+protected:
+  display_info_t interface_get_info() const override;
+  void interface_set_attributes(const display_attr_t &attributes) override;
+  void interface_write_bitmap(const sgfx::Bitmap &bitmap) override;
+  void interface_refresh() override;
+  bool interface_is_busy() const override;
+  void interface_set_palette(const display_palette_t &palette) override;
+  display_palette_t interface_get_palette() const override;
+
+private:
+  fs::File m_file;
 };
 
 } // namespace ux
 
-#endif /* UXAPI_UX_DISPLAYDEVICE_HPP_ */
+#endif // UXAPI_UX_DISPLAYDEVICE_HPP_
@@ -0,0 +1,86 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#ifndef UXAPI_UX_FRAMEBUFFERDISPLAYDEVICE_HPP_
+#define UXAPI_UX_FRAMEBUFFERDISPLAYDEVICE_HPP_
+
+#include <var/Vector.hpp>
+
+#include "DisplayDevice.hpp"
+
+namespace ux {
+
+/*! \brief Framebuffer Display Device Class
+ * \details This class is a display device that keeps the pixels in
+ * memory. Bitmaps written to the display are copied to the current
+ * window of bitmap().
+ *
+ * The device counts the requests it receives and the bytes that
+ * would be sent to a panel so drawing can be checked and measured
+ * without display hardware.
+ *
+ * \code
+ * FramebufferDisplayDevice device(
+ *   sgfx::Area(128, 64),
+ *   sgfx::Bitmap::BitsPerPixel::x1);
+ * Display display(device);
+ * // ... run the event loop
+ * printf("wrote %ld bytes\n", device.write_size());
+ * \endcode
+ *
+ */
+class FramebufferDisplayDevice : public DisplayDevice {
+public:
+  FramebufferDisplayDevice(
+    const sgfx::Area &area,
+    sgfx::Bitmap::BitsPerPixel bits_per_pixel);
+
+  const sgfx::Bitmap &bitmap() const { return m_bitmap; }
+  const sgfx::Region &window() const { return m_window; }
+  bool is_enabled() const { return m_is_enabled; }
+  bool is_palette_mode() const { return m_is_palette_mode; }
+
+  /*! \details Returns the number of attribute requests (window,
+   * mode, enable, clear, and disable).
+   */
+  u32 attribute_count() const { return m_attribute_count; }
+  u32 write_count() const { return m_write_count; }
+
+  /*! \details Returns the number of pixel bytes written. */
+  u32 write_size() const { return m_write_size; }
+  u32 refresh_count() const { return m_refresh_count; }
+
+  void reset_statistics() {
+    m_attribute_count = 0;
+    m_write_count = 0;
+    m_write_size = 0;
+    m_refresh_count = 0;
+  }
+
+protected:
+  display_info_t interface_get_info() const override;
+  void interface_set_attributes(const display_attr_t &attributes) override;
+  void interface_write_bitmap(const sgfx::Bitmap &bitmap) override;
+  void interface_refresh() override { m_refresh_count++; }
+  bool interface_is_busy() const override { return false; }
+  void interface_set_palette(const display_palette_t &palette) override;
+  display_palette_t interface_get_palette() const override;
+
+  /*! \details Returns the number of bytes in the current window. */
+  u32 calculate_window_size() const;
+
+private:
+  sgfx::BitmapData m_bitmap;
+  sgfx::Region m_window;
+  var::Vector<sg_color_t> m_palette_colors;
+  u8 m_palette_pixel_format = 0;
+  bool m_is_enabled = false;
+  bool m_is_palette_mode = false;
+  u32 m_attribute_count = 0;
+  u32 m_write_count = 0;
+  u32 m_write_size = 0;
+  u32 m_refresh_count = 0;
+};
+
+} // namespace ux
+
+#endif // UXAPI_UX_FRAMEBUFFERDISPLAYDEVICE_HPP_
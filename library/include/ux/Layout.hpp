@@ -149,6 +149,13 @@ public:
   void scroll(DrawingPoint value);
   void erase_region(DrawingRegion region);
 
+  void invalidate_refresh() override;
+
+  /*! \details Forces the components that overlap \a region (on the
+   * display bitmap) to write to the display on their next refresh.
+   */
+  void invalidate_refresh_region(const sgfx::Region &region);
+
   virtual void draw(const DrawingAttributes &attributes);
 
   void distribute_event(const ux::Event &event);
@@ -162,19 +169,29 @@ public:
   const DrawingPoint &origin() const { return m_origin; }
 
 protected:
+  DrawingPoint m_origin;
+  DrawingArea m_area;
+
+  /*! \details Assigns the drawing point of each item and the area
+   * of the layout. Layouts that position items themselves (such as
+   * VirtualList) override this.
+   */
+  virtual void generate_layout_positions();
+
+  /*! \details Converts a vertical drag of \a scroll pixels to the
+   * drawing units the layout origin is shifted by.
+   */
+  virtual drawing_int_t handle_vertical_scroll(sg_int_t scroll);
+
 private:
   friend class Controller;
   friend class EventLoop;
   API_AF(Layout, Flow, flow, Flow::free);
   API_ACCESS_COMPOUND(Layout, var::Vector<Item>, component_list);
-  DrawingPoint m_origin;
-  DrawingArea m_area;
 
   void shift_origin(DrawingPoint shift);
-  drawing_int_t handle_vertical_scroll(sg_int_t scroll);
   drawing_int_t handle_horizontal_scroll(sg_int_t scroll);
 
-  void generate_layout_positions();
   void generate_vertical_layout_positions();
   void generate_vertical_no_scroll_layout_positions();
   void generate_horizontal_layout_positions();
@@ -0,0 +1,94 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#ifndef UXAPI_UX_SIMULATEDDISPLAYDEVICE_HPP_
+#define UXAPI_UX_SIMULATEDDISPLAYDEVICE_HPP_
+
+#include <chrono/ClockTimer.hpp>
+
+#include "FramebufferDisplayDevice.hpp"
+
+namespace ux {
+
+/*! \brief Simulated Display Device Class
+ * \details This class is a framebuffer display device that takes as
+ * long as a panel on a serial bus to handle requests.
+ *
+ * - Each request sends `command_size` bytes over the bus and each
+ *   write also sends the pixels in the window. The caller is blocked
+ *   while the bytes are sent at `bus_frequency` bits per second.
+ * - refresh() keeps the panel busy (see is_busy()) for
+ *   `refresh_latency`. Requests made while the panel is busy wait
+ *   until the refresh is complete.
+ *
+ * The time spent on the bus and waiting for the panel is counted, so
+ * the frame rate of an application can be measured and tuned on a
+ * computer.
+ *
+ * \code
+ * SimulatedDisplayDevice device(SimulatedDisplayDevice::Construct()
+ *                                 .set_area(sgfx::Area(240, 240))
+ *                                 .set_bus_frequency(20000000)
+ *                                 .set_refresh_latency(16_milliseconds));
+ * Display display(device);
+ * // ... run the event loop
+ * printf("bus %ldus\n", device.bus_time().microseconds());
+ * \endcode
+ *
+ */
+class SimulatedDisplayDevice : public FramebufferDisplayDevice {
+public:
+  class Construct {
+    API_AC(Construct, sgfx::Area, area);
+    API_AF(
+      Construct,
+      sgfx::Bitmap::BitsPerPixel,
+      bits_per_pixel,
+      sgfx::Bitmap::BitsPerPixel::x16);
+    API_AF(Construct, u32, bus_frequency, 20000000);
+    API_AF(Construct, u32, command_size, 11);
+    API_AF(Construct, chrono::MicroTime, refresh_latency, 16_milliseconds);
+  };
+
+  explicit SimulatedDisplayDevice(const Construct &options);
+
+  /*! \details Returns the time spent sending commands and pixels. */
+  const chrono::MicroTime &bus_time() const { return m_bus_time; }
+
+  /*! \details Returns the time requests waited for a refresh. */
+  const chrono::MicroTime &busy_wait_time() const {
+    return m_busy_wait_time;
+  }
+
+  /*! \details Returns the number of times is_busy() returned true. */
+  u32 busy_count() const { return m_busy_count; }
+
+  void reset_statistics() {
+    FramebufferDisplayDevice::reset_statistics();
+    m_bus_time = chrono::MicroTime(0);
+    m_busy_wait_time = chrono::MicroTime(0);
+    m_busy_count = 0;
+  }
+
+protected:
+  display_info_t interface_get_info() const override;
+  void interface_set_attributes(const display_attr_t &attributes) override;
+  void interface_write_bitmap(const sgfx::Bitmap &bitmap) override;
+  void interface_refresh() override;
+  bool interface_is_busy() const override;
+  void interface_set_palette(const display_palette_t &palette) override;
+
+private:
+  Construct m_construct;
+  chrono::ClockTimer m_clock;
+  chrono::MicroTime m_busy_until;
+  chrono::MicroTime m_bus_time;
+  chrono::MicroTime m_busy_wait_time;
+  mutable u32 m_busy_count = 0;
+
+  void wait_until_ready();
+  void transfer(u32 size);
+};
+
+} // namespace ux
+
+#endif // UXAPI_UX_SIMULATEDDISPLAYDEVICE_HPP_
@@ -4,6 +4,7 @@
 #define UXAPI_UX_TEXTAREA_HPP
 
 #include "Component.hpp"
+#include "TextBuffer.hpp"
 #include "TouchGesture.hpp"
 #include "draw/TextBox.hpp"
 
@@ -16,30 +17,51 @@ public:
   void draw(const DrawingScaledAttributes &attributes);
   void handle_event(const ux::Event &event);
 
+  /*! \details Inserts \a text at \a position of text_buffer().
+   *
+   * Only the paragraphs (text between newlines) that the edit
+   * touches are wrapped again, and only the lines that change (or
+   * move) are drawn and written to the display.
+   */
+  TextArea &insert(size_t position, const var::StringView text);
+
+  /*! \details Removes \a length bytes at \a position of
+   * text_buffer(). See insert().
+   */
+  TextArea &remove(size_t position, size_t length);
+
   TextArea &append(const var::StringView input) {
-    return set_value(value() + input);
+    return insert(m_text_buffer.size(), input);
   }
 
+  /*! \details Returns the text that is shown when the display text
+   * is not set. Edit it with insert(), remove(), and append().
+   */
+  const TextBuffer &text_buffer() const { return m_text_buffer; }
+
   TextArea &scroll_top() {
     m_text_box.set_scroll(0);
+    m_line_scroll = 0;
     return *this;
   }
 
   TextArea &scroll_bottom() {
     m_text_box.set_scroll(draw::TextBox::maximum_scroll());
+    m_line_scroll = m_line_scroll_total;
     return *this;
   }
 
   size_t scroll() const {
-    return m_text_box.scroll();
+    return is_buffer_mode() ? m_line_scroll : m_text_box.scroll();
   }
 
   size_t scroll_total() const {
-    return m_text_box.scroll_total();
+    return is_buffer_mode() ? m_line_scroll_total : m_text_box.scroll_total();
   }
 
   TextArea & set_display_text(const var::StringView value){
     m_display_text = value;
+    m_text_box.refresh_string();
     return *this;
   }
 
@@ -54,6 +76,39 @@ private:
   sg_size_t m_line_height = 0;
   draw::TextBox m_text_box;
   var::StringView m_display_text;
+
+  // the wrapped lines of the text between two newlines
+  struct Paragraph {
+    u32 length;
+    bool is_wrapped;
+    var::Vector<draw::TextBox::Line> line_list;
+  };
+
+  TextBuffer m_text_buffer;
+  var::Vector<Paragraph> m_paragraph_list;
+  // bytes of the paragraph or line being wrapped or drawn
+  var::Data m_scratch;
+  const sgfx::Font *m_layout_font = nullptr;
+  sgfx::Region m_text_region;
+  size_t m_line_count = 0;
+  size_t m_line_scroll = 0;
+  size_t m_line_scroll_total = 0;
+
+  bool is_buffer_mode() const { return m_display_text.is_empty(); }
+
+  size_t find_paragraph(size_t position, size_t &paragraph_offset) const;
+  Paragraph create_paragraph(size_t length) const {
+    return Paragraph{u32(length), false, var::Vector<draw::TextBox::Line>()};
+  }
+  var::StringView read_text(size_t position, size_t length);
+  void wrap_paragraphs();
+  void update_scroll();
+  sgfx::Region draw_lines(sgfx::Bitmap &bitmap, size_t first, size_t last);
+  void update_edited_lines(
+    size_t first,
+    size_t last,
+    size_t previous_line_count);
+  size_t count_lines(size_t first, size_t last) const;
 };
 
 } // namespace ux
@@ -0,0 +1,84 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#ifndef UXAPI_UX_TEXTBUFFER_HPP
+#define UXAPI_UX_TEXTBUFFER_HPP
+
+#include <var/String.hpp>
+#include <var/StringView.hpp>
+#include <var/Vector.hpp>
+
+namespace ux {
+
+/*! \brief Text Buffer Class
+ * \details A text buffer is editable text stored as a piece table.
+ * The text is a list of pieces that each refer to a span of the
+ * original text or of a buffer that inserted text is appended to.
+ * Inserting or removing text splits or trims pieces rather than
+ * moving the text after the edit, so edits cost the same at the end
+ * of a large log as they do in a short string.
+ *
+ * \code
+ * TextBuffer buffer("hello world");
+ * buffer.insert(5, ",").append("\n");
+ * // buffer.to_string() == "hello, world\n"
+ * \endcode
+ *
+ */
+class TextBuffer {
+public:
+  TextBuffer() {}
+
+  /*! \details Constructs a buffer that shows \a original. The
+   * original text is used in place and must outlive the buffer.
+   */
+  explicit TextBuffer(const var::StringView original);
+
+  TextBuffer &insert(size_t position, const var::StringView text);
+  TextBuffer &remove(size_t position, size_t length);
+  TextBuffer &append(const var::StringView text) {
+    return insert(size(), text);
+  }
+  TextBuffer &clear();
+
+  size_t size() const { return m_size; }
+  bool is_empty() const { return m_size == 0; }
+
+  /*! \details Returns the number of pieces the text is stored in. */
+  size_t piece_count() const { return m_piece_list.count(); }
+
+  /*! \details Copies the text starting at \a position to
+   * \a destination and returns the number of bytes copied.
+   */
+  size_t read(size_t position, var::View destination) const;
+
+  char at(size_t position) const;
+
+  var::String to_string() const;
+
+private:
+  enum class Source : u8 { original, append };
+
+  struct Piece {
+    Source source;
+    u32 offset;
+    u32 length;
+  };
+
+  var::StringView m_original;
+  var::String m_append;
+  var::Vector<Piece> m_piece_list;
+  size_t m_size = 0;
+
+  const char *piece_data(const Piece &piece) const {
+    return (piece.source == Source::original ? m_original.data()
+                                             : m_append.cstring())
+           + piece.offset;
+  }
+
+  size_t find_piece(size_t position, size_t &piece_offset) const;
+  size_t split_piece(size_t position);
+};
+
+} // namespace ux
+
+#endif // UXAPI_UX_TEXTBUFFER_HPP
@@ -18,6 +18,11 @@ public:
     event_id_scroll_decremented
   };
 
+  /*! \details Selects how the file is shown. `raw` wraps the
+   * contents as text. `hexadecimal` and `binary` show fixed-width
+   * rows (16 and 4 bytes per row) so line N is at byte N times the
+   * row size without wrapping or indexing the file.
+   */
   enum class Encoding {
     raw,
     binary,
@@ -36,32 +41,123 @@ public:
   void draw(const DrawingScaledAttributes &attributes);
   void handle_event(const ux::Event &event);
 
-  TextFileArea &scroll_top() {
-    m_text_box.set_scroll(0);
-    return *this;
-  }
+  TextFileArea &scroll_top() { return scroll_to(0); }
 
   TextFileArea &scroll_bottom() {
-    m_text_box.set_scroll(draw::TextBox::maximum_scroll());
-    return *this;
+    const size_t total = scroll_total();
+    return scroll_to(total ? total - 1 : 0);
   }
 
   TextFileArea & set_display_text(const var::StringView value){
     m_display_text = value;
+    m_text_box.refresh_string();
     return *this;
   }
 
+  /*! \details Shows the file starting at wrapped line \a line.
+   *
+   * The line index is built while the component is drawn and
+   * receives periodic events. Lines that are indexed are found by
+   * seeking to the nearest checkpoint. Lines past the index are shown
+   * at a location estimated from the lines per byte indexed so far
+   * (at the start of a paragraph), and scroll() is corrected when the
+   * index reaches them. The lines before the estimate are not read.
+   *
+   * Call redraw() to show the change.
+   */
+  TextFileArea &scroll_to(size_t line);
+
   size_t scroll() const {
-    return m_scroll;
+    return m_line + (m_is_text_box_scroll_mode ? m_text_box.scroll() : 0);
+  }
+
+  /*! \details Returns the number of wrapped lines in the file. The
+   * value is estimated from the bytes that have been indexed until
+   * is_line_index_complete() is true.
+   */
+  size_t scroll_total() const;
+
+  /*! \details Returns true if every line in the file has been
+   * indexed. Files that grow continue to be indexed.
+   */
+  bool is_line_index_complete() const {
+    if (is_fixed_width()) {
+      return true;
+    }
+    return (m_index_font != nullptr) && (m_index_location >= m_content_size);
   }
 
-  size_t scroll_total() const {
-    return m_scroll_total;
+  Encoding encoding() const { return m_encoding; }
+
+  /*! \details Returns true if the file is shown as rows of a fixed
+   * number of bytes (see Encoding).
+   */
+  bool is_fixed_width() const { return m_encoding != Encoding::raw; }
+
+  /*! \details Returns the number of bytes on each row of a fixed
+   * width encoding (zero for Encoding::raw).
+   */
+  size_t bytes_per_line() const {
+    return m_encoding == Encoding::hexadecimal ? 16
+           : m_encoding == Encoding::binary    ? 4
+                                               : 0;
   }
 
 
 private:
-  static constexpr size_t m_scroll_total = 50;
+  /*! \details Reads pages of a fixed-width file into two halves of
+   * the page buffer. While one page is drawn the other can be read
+   * ahead so scrolling does not wait on the file.
+   */
+  class PageReader {
+  public:
+    void set_buffer(var::View buffer);
+
+    /*! \details Returns the bytes from \a location to \a location
+     * plus \a size (or the end of the file). The file is read only
+     * if neither page contains the bytes.
+     */
+    var::View
+    get(const fs::FileObject &source, size_t location, size_t size, size_t end);
+
+    /*! \details Reads the page that starts at \a location into the
+     * page that is not being used.
+     */
+    void prefetch(const fs::FileObject &source, size_t location, size_t end);
+
+    size_t page_size() const { return m_page[0].buffer.size(); }
+    size_t location() const { return m_page[m_current].location; }
+
+    void invalidate() {
+      m_page[0].size = 0;
+      m_page[1].size = 0;
+    }
+
+  private:
+    struct Page {
+      var::View buffer;
+      size_t location = 0;
+      size_t size = 0;
+
+      bool contains(size_t value, size_t value_size) const {
+        return (value >= location) && (value + value_size <= location + size);
+      }
+    };
+
+    Page m_page[2];
+    u8 m_current = 0;
+
+    size_t read(
+      const fs::FileObject &source,
+      Page &page,
+      size_t location,
+      size_t end);
+  };
+
+  // wrapped lines between entries of m_checkpoint_list
+  static constexpr size_t checkpoint_interval = 32;
+  // line index chunks read for each periodic event
+  static constexpr size_t index_chunk_count = 16;
 
   API_ACCESS_FUNDAMENTAL(TextFileArea, drawing_size_t, text_height, 0);
   API_ACCESS_FUNDAMENTAL(TextFileArea, drawing_size_t, offset, 0);
@@ -76,8 +172,30 @@ private:
   sg_size_t m_line_height = 0;
   draw::TextBox m_text_box;
   var::StringView m_display_text;
-  size_t m_scroll = 0;
   bool m_is_text_box_scroll_mode = false;
+  bool m_is_content_size_fixed = false;
+  bool m_is_scroll_forward = true;
+  Encoding m_encoding = Encoding::raw;
+  PageReader m_page_reader;
+  size_t m_visible_line_count = 0;
+
+  // line index: the content offset of every checkpoint_interval line
+  var::Vector<u32> m_checkpoint_list;
+  const sgfx::Font *m_index_font = nullptr;
+  size_t m_index_width = 0;
+  size_t m_index_location = 0;
+  size_t m_index_line_count = 0;
+  // the size of a growing file when the index last waited for the end
+  // of its last paragraph
+  size_t m_index_wait_size = 0;
+  // a last paragraph without a newline is indexed once the file stops
+  // growing and indexed again if it grows
+  bool m_is_index_tail = false;
+  size_t m_index_tail_location = 0;
+  size_t m_index_tail_line_count = 0;
+  size_t m_line = 0;
+  // m_line is estimated until the index reaches the page
+  bool m_is_line_estimated = false;
 
   size_t calculate_remaining() const {
     const auto content_size = (m_content_location + m_content_size) - m_source->location();
@@ -85,6 +203,19 @@ private:
   }
 
   void load_page_buffer();
+  void draw_fixed_width(const DrawingScaledAttributes &attributes);
+  size_t format_line(const var::View data, size_t location, char *line) const;
+  void update_content_size();
+  void load_line(size_t line);
+  bool update_line_index();
+  size_t find_line_location(size_t line);
+  size_t estimate_line_location(size_t line);
+  size_t find_previous_line_location(size_t location) const;
+  size_t read_lines(
+    size_t location,
+    var::GeneralString &buffer,
+    var::Vector<draw::TextBox::Line> &line_list,
+    bool is_tail) const;
   void handle_increment_scroll();
   void handle_decrement_scroll();
 };
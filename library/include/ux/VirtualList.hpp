@@ -0,0 +1,95 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#ifndef UXAPI_UX_VIRTUALLIST_HPP
+#define UXAPI_UX_VIRTUALLIST_HPP
+
+#include <functional>
+
+#include "List.hpp"
+
+namespace ux {
+
+/*! \brief Virtual List Class
+ * \details A virtual list shows entries from a data source rather
+ * than one component per entry. Only the visible rows (plus
+ * `overscan` rows above and below) exist as ListItem components.
+ * As the list scrolls, rows that move out of view are bound to the
+ * entries that move into view, so a list of thousands of entries
+ * uses the same memory as a screen of rows.
+ *
+ * The data source is two callbacks: one that returns the number of
+ * entries and one that assigns an entry to a row.
+ *
+ * \code
+ * list.set_data_source(
+ *   [&]() { return file_list.count(); },
+ *   [&](size_t index, ListItem &item) {
+ *     item.set_label(file_list.at(index));
+ *   });
+ * \endcode
+ *
+ * Call reload() when the entries change. Events from the rows have
+ * the row as the component; use get_index() to find the entry.
+ *
+ */
+class VirtualList : public LayoutAccess<VirtualList> {
+public:
+  using Count = std::function<size_t()>;
+  using Bind = std::function<void(size_t index, ListItem &item)>;
+
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  VirtualList(const var::StringView name) : LayoutAccess(name) {
+    set_flow(Flow::vertical);
+    set_vertical_scroll_enabled();
+  }
+
+  VirtualList &set_data_source(Count count, Bind bind) {
+    m_count = count;
+    m_bind = bind;
+    return reload();
+  }
+
+  /*! \details Binds the rows again. Call this when the entries
+   * change.
+   */
+  VirtualList &reload();
+
+  /*! \details Scrolls so that entry \a index is at the top of the
+   * list (or as close as the number of entries allows).
+   */
+  VirtualList &scroll_to(size_t index);
+
+  /*! \details Returns the entry that is bound to \a component or
+   * npos if \a component is not a visible row of this list.
+   */
+  size_t get_index(const Component *component) const;
+
+  size_t count() const { return m_count ? m_count() : 0; }
+
+  /*! \details Returns the distance (in drawing units) from the top
+   * of the first entry to the top of the list.
+   */
+  u32 scroll_position() const { return m_scroll; }
+
+protected:
+  void generate_layout_positions() override;
+  drawing_int_t handle_vertical_scroll(sg_int_t scroll) override;
+
+private:
+  API_ACCESS_FUNDAMENTAL(VirtualList, drawing_size_t, item_height, 250);
+  API_ACCESS_FUNDAMENTAL(VirtualList, u8, overscan, 1);
+
+  Count m_count;
+  Bind m_bind;
+  u32 m_scroll = 0;
+  // the entry bound to each row (rows are components in order)
+  var::Vector<size_t> m_index_list;
+
+  u32 calculate_maximum_scroll() const;
+  void update_row_count();
+};
+
+} // namespace ux
+
+#endif // UXAPI_UX_VIRTUALLIST_HPP
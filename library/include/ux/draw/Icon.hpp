@@ -19,6 +19,7 @@ public:
     } else {
       m_name = var::String(value);
     }
+    m_index_font = nullptr;
     return *this;
   }
 
@@ -31,6 +32,10 @@ private:
   API_ACCESS_FUNDAMENTAL(Icon, sg_color_t, color, 0);
   sg_region_t m_bounds;
   const sgfx::IconFont *m_icon_font;
+  // the icon offset is looked up once for each name and font revision
+  const sgfx::IconFont *m_index_font = nullptr;
+  u32 m_index_revision = 0;
+  size_t m_icon_index = 0;
 
   const sgfx::IconFont *icon_font() { return m_icon_font; }
 
@@ -3,6 +3,8 @@
 #ifndef UXAPI_UX_DRAW_RICHTEXT_HPP_
 #define UXAPI_UX_DRAW_RICHTEXT_HPP_
 
+#include <var/String.hpp>
+
 #include "../Drawing.hpp"
 #include "../sgfx/Font.hpp"
 #include "../sgfx/IconFont.hpp"
@@ -10,10 +12,46 @@
 namespace ux::draw {
 
 
+/*! \brief Rich Text Class
+ * \details Rich text is a string of words and icons separated by
+ * spaces. Icons are written as `:<icon name>:`.
+ *
+ * The string is parsed into a list of runs (a span of the string or an
+ * icon offset) with the width and height of each run. Run lists are
+ * kept in a shared cache identified by the fonts and a copy of the
+ * string (found using its hash), so drawing the same string again
+ * (for example, when a list is scrolled) does not split the string,
+ * search for icons, or measure text.
+ *
+ */
 class RichText : public Drawing, public DrawingComponentProperties<RichText> {
 public:
   virtual void draw(const DrawingScaledAttributes &attr);
 
+  /*! \details Sets the number of run lists that are cached. The
+   * least recently used lists are discarded. A value of zero disables
+   * the cache.
+   */
+  static void set_run_cache_capacity(size_t value);
+  static size_t run_cache_capacity() { return m_run_cache_capacity; }
+  static void clear_run_cache() { m_run_cache = var::Vector<RunList>(); }
+
+  static u32 run_cache_hit_count() { return m_run_cache_hit_count; }
+  static u32 run_cache_miss_count() { return m_run_cache_miss_count; }
+
+  /*! \details Draws anti-aliased text fonts using the blend table of
+   * \a theme for \a style and \a state (see Theme::get_blend_table()).
+   */
+  RichText &set_blend_theme(
+    const sgfx::Theme *theme,
+    sgfx::Theme::Style style,
+    sgfx::Theme::State state) {
+    m_blend_theme = theme;
+    m_blend_style = style;
+    m_blend_state = state;
+    return *this;
+  }
+
 protected:
   API_ACCESS_COMPOUND(RichText, var::StringView, value);
   API_ACCESS_COMPOUND(RichText, var::StringView, text_font_name);
@@ -29,17 +67,76 @@ protected:
   API_ACCESS_FUNDAMENTAL(RichText, sg_color_t, color, 0);
   bool resolve_fonts(sg_size_t h);
 
-  class RichToken {
+  class Run {
   public:
     enum class Type { text, icon };
 
   private:
-    API_ACCESS_FUNDAMENTAL(RichToken, sg_size_t, width, 0);
-    API_ACCESS_FUNDAMENTAL(RichToken, sg_size_t, height, 0);
-    API_ACCESS_FUNDAMENTAL(RichToken, Type, type, Type::text);
-    API_ACCESS_FUNDAMENTAL(RichToken, u32, icon_index, 0);
-    API_ACCESS_COMPOUND(RichToken, var::StringView, value);
+    API_ACCESS_FUNDAMENTAL(Run, sg_size_t, width, 0);
+    API_ACCESS_FUNDAMENTAL(Run, sg_size_t, height, 0);
+    API_ACCESS_FUNDAMENTAL(Run, Type, type, Type::text);
+    API_ACCESS_FUNDAMENTAL(Run, u32, icon_index, 0);
+    // the span of value() that holds the text (or icon name)
+    API_ACCESS_FUNDAMENTAL(Run, u16, offset, 0);
+    API_ACCESS_FUNDAMENTAL(Run, u16, length, 0);
   };
+
+  class RunList {
+  public:
+    API_ACCESS_FUNDAMENTAL(RunList, const sgfx::Font *, text_font, nullptr);
+    API_ACCESS_FUNDAMENTAL(
+      RunList,
+      const sgfx::IconFont *,
+      icon_font,
+      nullptr);
+    // icon offsets are found again when the icon font is refreshed
+    API_ACCESS_FUNDAMENTAL(RunList, u32, icon_font_revision, 0);
+    API_ACCESS_FUNDAMENTAL(RunList, u64, key, 0);
+    API_ACCESS_FUNDAMENTAL(RunList, u32, last_access, 0);
+    API_ACCESS_FUNDAMENTAL(RunList, sg_size_t, total_width, 0);
+    API_ACCESS_FUNDAMENTAL(RunList, sg_size_t, max_height, 0);
+
+  public:
+    bool is_match(
+      const sgfx::Font *text_font,
+      const sgfx::IconFont *icon_font,
+      u64 key,
+      const var::StringView string) const {
+      // the key only rules lists out, the string must be compared
+      return (m_text_font == text_font) && (m_icon_font == icon_font)
+             && (m_icon_font_revision
+                 == (icon_font ? icon_font->revision() : 0))
+             && (m_key == key) && (m_string == string);
+    }
+
+    RunList &set_string(const var::StringView value) {
+      m_string = var::String(value);
+      return *this;
+    }
+
+    const var::Vector<Run> &list() const { return m_list; }
+    var::Vector<Run> &list() { return m_list; }
+
+  private:
+    var::String m_string;
+    var::Vector<Run> m_list;
+  };
+
+  const RunList &get_run_list(RunList &scratch) const;
+  void build_run_list(RunList &run_list) const;
+
+private:
+  const sgfx::Theme *m_blend_theme = nullptr;
+  sgfx::Theme::Style m_blend_style = sgfx::Theme::Style::dark;
+  sgfx::Theme::State m_blend_state = sgfx::Theme::State::default_;
+
+  static var::Vector<RunList> m_run_cache;
+  static size_t m_run_cache_capacity;
+  static u32 m_run_cache_access_count;
+  static u32 m_run_cache_hit_count;
+  static u32 m_run_cache_miss_count;
+
+  static u64 calculate_key(const sgfx::Font *font, const var::StringView value);
 };
 
 } // namespace ux::draw
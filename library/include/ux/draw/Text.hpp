@@ -4,6 +4,7 @@
 #define UXAPI_UX_DRAW_TEXT_HPP_
 
 #include "../Drawing.hpp"
+#include "../sgfx/BlendTable.hpp"
 #include "../sgfx/Font.hpp"
 
 namespace ux::draw {
@@ -12,11 +13,32 @@ class Text : public Drawing, public DrawingComponentProperties<Text> {
 public:
   virtual void draw(const DrawingScaledAttributes &attr);
 
+  /*! \details Sets the string that is drawn. The string is not
+   * copied.
+   *
+   * Layouts (see TextBox) are kept if \a value refers to the same
+   * characters as the current string, so the string can be set each
+   * time it is drawn. Call refresh_string() if the characters are
+   * changed in place.
+   */
   Text &set_string(const var::StringView value) {
+    if (
+      (value.data() != m_string.data())
+      || (value.length() != m_string.length())) {
+      m_revision++;
+    }
     m_string = value;
     return *this;
   }
 
+  /*! \details Discards layouts of the string after its characters
+   * are changed in place.
+   */
+  Text &refresh_string() {
+    m_revision++;
+    return *this;
+  }
+
   Text &set_color(sg_color_t value) {
     m_color = value;
     return *this;
@@ -46,6 +68,32 @@ public:
   }
 
   sgfx::Font::Style font_style() const { return m_font_style; }
+
+  /*! \details Draws anti-aliased fonts using \a value rather than
+   * the text color. The table must outlive the drawing.
+   */
+  Text &set_blend_table(const sgfx::BlendTable *value) {
+    m_blend_table = value;
+    return *this;
+  }
+
+  const sgfx::BlendTable *blend_table() const { return m_blend_table; }
+
+  /*! \details Draws anti-aliased fonts (see Font::is_antialiased())
+   * using the blend table of \a theme for \a style and \a state
+   * (see Theme::get_blend_table()). A table set with
+   * set_blend_table() is used instead if there is one.
+   */
+  Text &set_blend_theme(
+    const sgfx::Theme *theme,
+    sgfx::Theme::Style style,
+    sgfx::Theme::State state) {
+    m_blend_theme = theme;
+    m_blend_style = style;
+    m_blend_state = state;
+    return *this;
+  }
+
   sg_size_t get_width(const var::StringView sample, sg_size_t height);
 
 protected:
@@ -56,7 +104,23 @@ protected:
   const sgfx::Font *m_font = nullptr;
   sg_size_t m_font_point_size = 0;
   sgfx::Font::Style m_font_style = sgfx::Font::Style::regular;
-  sg_color_t m_color;
+  sg_color_t m_color = 1;
+  const sgfx::BlendTable *m_blend_table = nullptr;
+  const sgfx::Theme *m_blend_theme = nullptr;
+  // changes when a different string is set so layouts can be kept;
+  // layouts compare the font themselves because it can be resolved
+  // by name when drawn
+  u32 m_revision = 1;
+  sgfx::Theme::Style m_blend_style = sgfx::Theme::Style::dark;
+  sgfx::Theme::State m_blend_state = sgfx::Theme::State::default_;
+
+  const sgfx::BlendTable *get_blend_table(const sgfx::Font *font) const;
+
+  void draw_string(
+    const sgfx::Font *font,
+    const var::StringView value,
+    const DrawingScaledAttributes &attr,
+    const sgfx::Point &point) const;
 };
 
 } // namespace ux::draw
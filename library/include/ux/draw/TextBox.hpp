@@ -7,6 +7,15 @@
 
 namespace ux::draw {
 
+/*! \brief Text Box Class
+ * \details This class draws a string wrapped to the width of the
+ * drawing.
+ *
+ * The wrapped lines are kept until the string or font is set again
+ * or the width changes, so a string that is modified in place must
+ * be set again with set_string().
+ *
+ */
 class TextBox : public Text {
 public:
   TextBox();
@@ -22,6 +31,22 @@ public:
     const var::StringView string,
     sg_size_t width);
 
+  /*! \brief A wrapped line of text */
+  struct Line {
+    u32 offset /*! Where the line starts in the string */;
+    u32 length /*! Number of bytes drawn (not including the break) */;
+    sg_int_t width /*! Width of the line when drawn */;
+  };
+
+  /*! \details Wraps \a string to \a width the same way draw() does
+   * and assigns the lines to \a line_list.
+   */
+  static void build_line_list(
+    const sgfx::Font *font,
+    const var::StringView string,
+    sg_size_t width,
+    var::Vector<Line> &line_list);
+
   virtual void draw(const DrawingScaledAttributes &attr);
 
   static constexpr sg_size_t maximum_scroll() { return 65535; }
@@ -40,22 +65,34 @@ public:
     return *this;
   }
 
-  size_t build_line(u32 &token_position,
-    var::GeneralString &line,
-    const var::StringViewList &tokens, sg_size_t width) const;
-
 private:
   API_AF(TextBox, sg_size_t, scroll, 0);
   API_RAF(TextBox, sg_size_t, scroll_total, 0);
   API_RAF(TextBox, sg_size_t, first_line_length, 0);
 
+  var::Vector<Line> m_line_list;
+  const sgfx::Font *m_line_font = nullptr;
+  sg_size_t m_line_width = 0;
+  u32 m_line_revision = 0;
+
+  // advances of the paragraph being wrapped; shared by all text boxes
+  // and only grows so wrapping text does not allocate once it is
+  // large enough for the longest paragraph
+  static var::Vector<sg_int_t> m_advance_list;
+
   int count_lines(sg_size_t width);
+  const var::Vector<Line> &update_line_list(sg_size_t width);
+
+  static void measure_line(
+    const sgfx::Font *font,
+    const var::StringView line,
+    var::Vector<sg_int_t> &advance_list);
 
-  static size_t build_line(
+  static var::StringView build_line(
     const sgfx::Font *font,
-    u32 &token_position,
-    var::GeneralString &line,
-    const var::StringViewList &tokens,
+    const var::StringView input_line,
+    const var::Vector<sg_int_t> &advance_list,
+    size_t &offset,
     int &build_len,
     sg_size_t width);
 };
@@ -5,6 +5,7 @@
 
 namespace ux::fmt {}
 
+#include "fmt/AssetPack.hpp"
 #include "fmt/Bmp.hpp"
 #include "fmt/Svic.hpp"
 
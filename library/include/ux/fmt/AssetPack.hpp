@@ -0,0 +1,176 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#ifndef UXAPI_UX_FMT_ASSETPACK_HPP_
+#define UXAPI_UX_FMT_ASSETPACK_HPP_
+
+#include <fs/File.hpp>
+#include <var/Vector.hpp>
+
+#include "../sgfx/Font.hpp"
+#include "../sgfx/MemoryMap.hpp"
+
+namespace ux::fmt {
+
+/*! \brief Asset Pack Class
+ * \details An asset pack is a single file that holds fonts, icon
+ * fonts, bitmaps, and vector icons. The file starts with an index
+ * that is sorted by type, name, style, and point size so assets are
+ * found using a binary search rather than by scanning directories
+ * and parsing file names.
+ *
+ * The pack is memory-mapped (or read once) when it is opened. The
+ * index and the assets are then used in place.
+ *
+ * ```
+ * header_t header;
+ * entry_t entry0;
+ * entry_t entry1;
+ * ...
+ * asset data (each asset is 32-bit aligned)
+ * ```
+ *
+ * \code
+ * AssetPack pack("/assets/assets.uxpack");
+ * const int offset = pack.find(
+ *   AssetPack::Type::font,
+ *   "sans",
+ *   Font::Style::bold,
+ *   16);
+ * if (offset >= 0) {
+ *   Font font(pack.at(offset).data());
+ * }
+ * \endcode
+ *
+ */
+class AssetPack : public api::ExecutionContext {
+public:
+  enum class Type { font, icon_font, bitmap, vector_icon };
+
+  typedef struct MCU_PACK {
+    u32 signature;
+    u16 version;
+    u16 entry_count;
+  } header_t;
+
+  typedef struct MCU_PACK {
+    char name[24];
+    u8 type;
+    u8 style;
+    u16 point_size;
+    u32 offset /*! Offset of the asset from the start of the pack */;
+    u32 size /*! Number of bytes in the asset */;
+  } entry_t;
+
+  class Entry {
+  public:
+    Entry() {}
+    Entry(const entry_t *entry, const var::View data)
+      : m_entry(entry), m_data(data) {}
+
+    bool is_valid() const { return m_entry != nullptr; }
+
+    Type type() const { return static_cast<Type>(m_entry->type); }
+    var::StringView name() const { return var::StringView(m_entry->name); }
+    sgfx::Font::Style style() const {
+      return static_cast<sgfx::Font::Style>(m_entry->style);
+    }
+    sg_size_t point_size() const { return m_entry->point_size; }
+
+    /*! \details Returns the contents of the asset (for example, a
+     * `.sbf` font file or a `.sbm` bitmap file).
+     */
+    const var::View data() const { return m_data; }
+
+  private:
+    const entry_t *m_entry = nullptr;
+    var::View m_data;
+  };
+
+  /*! \details Describes an asset when a pack is created. The style
+   * of icon fonts is always Font::Style::icons.
+   */
+  class Item {
+    API_AF(Item, Type, type, Type::font);
+    API_AC(Item, var::StringView, name);
+    API_AF(Item, sgfx::Font::Style, style, sgfx::Font::Style::any);
+    API_AF(Item, sg_size_t, point_size, 0);
+    API_AC(Item, var::View, data);
+  };
+
+  AssetPack() {}
+  explicit AssetPack(const var::StringView path)
+    : AssetPack(sgfx::MemoryMap(path)) {}
+  explicit AssetPack(const var::View view) : AssetPack(sgfx::MemoryMap(view)) {}
+  explicit AssetPack(sgfx::MemoryMap &&memory_map);
+
+  AssetPack(const AssetPack &a) = delete;
+  AssetPack &operator=(const AssetPack &a) = delete;
+
+  AssetPack(AssetPack &&a) { swap(a); }
+  AssetPack &operator=(AssetPack &&a) {
+    swap(a);
+    return *this;
+  }
+
+  bool is_valid() const { return m_entry_list != nullptr; }
+
+  u32 count() const { return m_entry_count; }
+
+  Entry at(u32 offset) const;
+
+  /*! \details Returns the offset of the first asset of \a type, or
+   * -1 if the pack has no assets of \a type.
+   */
+  int find(Type type) const;
+
+  /*! \details Returns the offset of the first asset of \a type named
+   * \a name (the one with the lowest style and point size), or -1
+   * if there is no such asset.
+   */
+  int find(Type type, const var::StringView name) const;
+
+  /*! \details Returns the offset of the asset that matches all of
+   * the arguments, or -1 if there is no such asset.
+   */
+  int find(
+    Type type,
+    const var::StringView name,
+    sgfx::Font::Style style,
+    sg_size_t point_size) const;
+
+  /*! \details Writes a pack that contains \a item_list to \a file.
+   * The items can be in any order.
+   */
+  static void
+  save(const fs::FileObject &file, const var::Vector<Item> &item_list);
+
+  static constexpr u32 signature() { return 0x50415855; }
+  static constexpr u16 version() { return 0x0100; }
+
+private:
+  sgfx::MemoryMap m_memory_map;
+  const entry_t *m_entry_list = nullptr;
+  u32 m_entry_count = 0;
+
+  static entry_t create_key(
+    Type type,
+    const var::StringView name,
+    sgfx::Font::Style style,
+    sg_size_t point_size);
+  static int compare(const entry_t &a, const entry_t &b);
+  static bool is_less(const entry_t &a, const entry_t &b) {
+    return compare(a, b) < 0;
+  }
+
+  u32 find_lower_bound(const entry_t &key) const;
+
+  void swap(AssetPack &a) {
+    std::swap(m_memory_map, a.m_memory_map);
+    std::swap(m_entry_list, a.m_entry_list);
+    std::swap(m_entry_count, a.m_entry_count);
+  }
+};
+
+} // namespace ux::fmt
+
+#endif // UXAPI_UX_FMT_ASSETPACK_HPP_
@@ -7,13 +7,20 @@ namespace ux::sgfx {}
 
 #include "sgfx/Api.hpp"
 #include "sgfx/Area.hpp"
+#include "sgfx/BitmapConverter.hpp"
+#include "sgfx/BlendTable.hpp"
+#include "sgfx/BitmapDiff.hpp"
+#include "sgfx/CanvasCache.hpp"
 #include "sgfx/Cursor.hpp"
 #include "sgfx/Font.hpp"
 #include "sgfx/IconFont.hpp"
+#include "sgfx/MemoryMap.hpp"
 #include "sgfx/Palette.hpp"
 #include "sgfx/Pen.hpp"
 #include "sgfx/Point.hpp"
 #include "sgfx/Region.hpp"
+#include "sgfx/RleBitmap.hpp"
+#include "sgfx/TextRunCache.hpp"
 #include "sgfx/Theme.hpp"
 #include "sgfx/Vector.hpp"
 
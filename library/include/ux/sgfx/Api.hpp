@@ -14,6 +14,11 @@ class Api : public api::ExecutionContext {
 public:
   static SgfxApi &api() { return m_api; }
 
+  /*! \details Returns true if the sgfx library is available and
+   * was built with the same version of sg_api_t as this library.
+   */
+  static bool is_api_valid();
+
 private:
   static SgfxApi m_api;
 };
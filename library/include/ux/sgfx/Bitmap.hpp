@@ -10,12 +10,15 @@
 
 #include "Api.hpp"
 
+#include "MemoryMap.hpp"
 #include "Palette.hpp"
 #include "Pen.hpp"
 #include "Region.hpp"
 
 namespace ux::sgfx {
 
+class RleBitmap;
+
 class BitmapFlags {
 public:
   using BitsPerPixel = PaletteFlags::BitsPerPixel;
@@ -86,6 +89,11 @@ public:
 
   static Area load_area(const var::StringView  path);
 
+  /*! \details Returns true if \a bits_per_pixel can be stored
+   * in a bitmap file (1, 2, 4, 8, 16, or 32).
+   */
+  static bool is_bits_per_pixel_valid(u8 bits_per_pixel);
+
   const Bitmap &transform_flip_x() const {
     api()->transform_flip_x(bmap());
     return *this;
@@ -237,6 +245,14 @@ public:
     return *this;
   }
 
+  /*! \details Draws a run-length encoded bitmap without
+   * decompressing it first.
+   *
+   * @param p_dest The point in the destination bitmap of the top left corner
+   * @param src The run-length encoded source bitmap
+   */
+  const Bitmap &draw_bitmap(const Point &p_dest, const RleBitmap &src) const;
+
   const Bitmap &apply_antialias_filter(
     const AntiAliasFilter &filter,
     const Region &bounds) const {
@@ -295,8 +311,28 @@ public:
     return *this;
   }
 
+  /*! \details Draws a subset of a run-length encoded bitmap. Only
+   * the rows within \a source_region are decoded.
+   */
+  const Bitmap &draw_sub_bitmap(
+    const Point &destination_point,
+    const RleBitmap &source_bitmap,
+    const Region &source_region) const;
+
   Region calculate_active_region() const;
 
+  /*! \details Calculates a 64-bit hash of the pixels in \a region.
+   *
+   * The hash can be compared to a previous value to see if the
+   * pixels have changed without keeping a copy of the bitmap.
+   */
+  u64 calculate_hash(const Region &region) const {
+    return api()->calc_bmap_hash(bmap(), &region.region());
+  }
+
+  /*! \details Calculates a 64-bit hash of all the pixels. */
+  u64 calculate_hash() const { return calculate_hash(region()); }
+
   Bitmap &invert_rectangle(const Region &region) {
     m_bmap.pen.o_flags = SG_PEN_FLAG_IS_INVERT;
     m_bmap.pen.color = 0xffffffff;
@@ -435,6 +471,70 @@ private:
   var::Data m_data;
 };
 
+/*! \brief Mapped Bitmap Class
+ * \details This class uses a read-only bitmap asset
+ * (sg_bmap_header_t followed by the bitmap data) in place.
+ *
+ * The header is validated once when the object is created. If
+ * the asset's bits per pixel are supported by the sgfx library,
+ * the bitmap points directly into the mapped data and no
+ * heap is used. Otherwise, the asset is converted the first time
+ * bitmap() is called.
+ *
+ * \code
+ * MappedBitmap splash("/assets/splash.sbm");
+ * display_bitmap.draw_bitmap(Point(), splash.bitmap());
+ * \endcode
+ *
+ */
+class MappedBitmap : public Api, public BitmapFlags {
+public:
+  MappedBitmap() {}
+  explicit MappedBitmap(const var::StringView path)
+    : MappedBitmap(MemoryMap(path)) {}
+  explicit MappedBitmap(const var::View view) : MappedBitmap(MemoryMap(view)) {}
+  explicit MappedBitmap(MemoryMap &&memory_map);
+
+  MappedBitmap(const MappedBitmap &a) = delete;
+  MappedBitmap &operator=(const MappedBitmap &a) = delete;
+  MappedBitmap(MappedBitmap &&a) = default;
+  MappedBitmap &operator=(MappedBitmap &&a) = default;
+
+  bool is_valid() const { return m_header.version != 0; }
+
+  /*! \details Returns true if the bitmap is used in place. */
+  bool is_zero_copy() const { return m_is_zero_copy; }
+
+  Area area() const { return Area(m_header.width, m_header.height); }
+
+  /*! \details Returns the bits per pixel of the stored asset. */
+  BitsPerPixel bits_per_pixel() const {
+    return static_cast<BitsPerPixel>(m_header.bits_per_pixel);
+  }
+
+  /*! \details Returns the raw (stored) pixel data. */
+  const var::View data() const { return m_data; }
+
+  /*! \details Returns a bitmap that can be drawn using the
+   * sgfx library. The bitmap is converted on the first call if
+   * needed.
+   */
+  const Bitmap &bitmap() const;
+
+  const MemoryMap &memory_map() const { return m_memory_map; }
+
+private:
+  MemoryMap m_memory_map;
+  sg_bmap_header_t m_header = {};
+  var::View m_data;
+  bool m_is_zero_copy = false;
+  mutable bool m_is_ready = false;
+  mutable Bitmap m_bitmap;
+  mutable BitmapData m_converted;
+
+  void convert() const;
+};
+
 } // namespace ux::sgfx
 
 namespace printer {
@@ -0,0 +1,70 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#ifndef UXAPI_UX_SGFX_BITMAPCONVERTER_HPP_
+#define UXAPI_UX_SGFX_BITMAPCONVERTER_HPP_
+
+#include "Bitmap.hpp"
+
+namespace ux::sgfx {
+
+/*! \brief Bitmap Converter Class
+ * \details This class converts bitmaps from one bits per
+ * pixel value to another one row at a time using the sgfx library.
+ *
+ * By default, colors keep their most significant bits when the
+ * bits per pixel are reduced and keep their value when they are
+ * increased. An explicit color map or a pair of palettes (nearest
+ * color match) can be used instead.
+ *
+ * \code
+ * BitmapData icon = BitmapConverter()
+ *   .set_palette(asset_palette, display_palette)
+ *   .load(File("/assets/icon.sbm"), BitmapConverter::BitsPerPixel::x4);
+ * \endcode
+ *
+ */
+class BitmapConverter : public Api, public BitmapFlags {
+public:
+  BitmapConverter() {}
+
+  /*! \details Sets the map from each source color to a destination
+   * color. The map must have an entry for every source color.
+   */
+  BitmapConverter &set_color_map(const var::Vector<sg_color_t> &value) {
+    m_color_map = value;
+    return *this;
+  }
+
+  /*! \details Maps each color in \a source to the nearest color
+   * in \a destination.
+   */
+  BitmapConverter &
+  set_palette(const Palette &source, const Palette &destination);
+
+  const var::Vector<sg_color_t> &color_map() const { return m_color_map; }
+
+  /*! \details Converts packed pixel data to \a destination. The
+   * data must have the same area as \a destination.
+   */
+  const BitmapConverter &convert(
+    const var::View source,
+    BitsPerPixel source_bits_per_pixel,
+    const Bitmap &destination) const;
+
+  BitmapData convert(const Bitmap &source, BitsPerPixel bits_per_pixel) const;
+
+  /*! \details Loads a bitmap file (sg_bmap_header_t followed by the data)
+   * and converts it to \a bits_per_pixel.
+   */
+  BitmapData
+  load(const fs::FileObject &file, BitsPerPixel bits_per_pixel) const;
+
+  static u32 find_nearest(const Palette &palette, const PaletteColor &color);
+
+private:
+  var::Vector<sg_color_t> m_color_map;
+};
+
+} // namespace ux::sgfx
+
+#endif // UXAPI_UX_SGFX_BITMAPCONVERTER_HPP_
@@ -0,0 +1,86 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#ifndef UXAPI_UX_SGFX_BITMAPDIFF_HPP_
+#define UXAPI_UX_SGFX_BITMAPDIFF_HPP_
+
+#include <var/Vector.hpp>
+
+#include "Bitmap.hpp"
+
+namespace ux::sgfx {
+
+/*! \brief Bitmap Diff Class
+ * \details This class compares two bitmaps that have the same
+ * area and bits per pixel and calculates a short list of regions
+ * that contain all the pixels that changed.
+ *
+ * Rows are compared one word at a time. Changed rows are grouped into
+ * bands. Each band is merged into the list as it is found: it is
+ * combined with the region that is cheapest to merge when doing so adds
+ * no more than `merge_cost` unchanged pixels or when the list is full.
+ * This avoids sending many small slivers to the display.
+ *
+ * The Compositor uses this class to send only the changed parts of a
+ * window that is written again.
+ *
+ * \code
+ * BitmapDiff diff(previous_frame, current_frame);
+ * for (const Region &region : diff.region_list()) {
+ *   display.set_window(region);
+ *   display.write_bitmap(Bitmap(current_frame).set_offset(region.point()));
+ * }
+ * \endcode
+ *
+ */
+class BitmapDiff : public Api {
+public:
+  class Options {
+    /*! \details The number of unchanged pixels that can be added to
+     * the regions in order to merge two regions.
+     */
+    API_AF(Options, u32, merge_cost, 256);
+    /*! \details The maximum number of regions. Regions are merged
+     * regardless of the cost until the list is no longer than this.
+     */
+    API_AF(Options, u16, maximum_region_count, 8);
+  };
+
+  BitmapDiff() {}
+  BitmapDiff(const Bitmap &previous, const Bitmap &current)
+    : BitmapDiff(previous, current, Options()) {}
+  BitmapDiff(
+    const Bitmap &previous,
+    const Bitmap &current,
+    const Options &options);
+
+  bool is_changed() const { return m_changed_pixel_count > 0; }
+
+  /*! \details Returns the regions that contain the changed pixels. */
+  const var::Vector<Region> &region_list() const { return m_region_list; }
+
+  /*! \details Returns the number of pixels that are different. */
+  u32 changed_pixel_count() const { return m_changed_pixel_count; }
+
+  /*! \details Returns the number of rows that have at least one
+   * changed pixel.
+   */
+  u32 changed_row_count() const { return m_changed_row_count; }
+
+  /*! \details Returns the number of pixels covered by the region list. */
+  u32 calculate_region_pixel_count() const;
+
+  /*! \details Returns the smallest region that contains all changes. */
+  Region calculate_bounds() const;
+
+private:
+  var::Vector<Region> m_region_list;
+  u32 m_changed_pixel_count = 0;
+  u32 m_changed_row_count = 0;
+
+  static u32 calculate_merge_cost(const Region &a, const Region &b);
+  void add_region(Region region, const Options &options);
+};
+
+} // namespace ux::sgfx
+
+#endif // UXAPI_UX_SGFX_BITMAPDIFF_HPP_
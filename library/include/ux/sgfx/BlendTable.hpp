@@ -0,0 +1,98 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#ifndef UXAPI_UX_SGFX_BLENDTABLE_HPP_
+#define UXAPI_UX_SGFX_BLENDTABLE_HPP_
+
+#include <var/Vector.hpp>
+
+#include "Bitmap.hpp"
+#include "Palette.hpp"
+
+namespace ux::sgfx {
+
+/*! \brief Blend Table Class
+ * \details This class maps each palette color and glyph coverage
+ * value to the palette color that is nearest to the blend of the
+ * two. Anti-aliased (2bpp or 4bpp coverage) glyphs are drawn on
+ * palette-indexed bitmaps using table lookups rather than
+ * per-pixel color math.
+ *
+ * Tables depend on the palette and the text color, so they are
+ * typically created once per theme style and state using
+ * Theme::create_blend_table().
+ *
+ * \code
+ * BlendTable blend_table = theme.create_blend_table(
+ *   Theme::Style::dark,
+ *   Theme::State::default_,
+ *   BlendTable::BitsPerPixel::x4);
+ *
+ * draw::Text().set_font(&font).set_blend_table(&blend_table) ...
+ * \endcode
+ *
+ */
+class BlendTable : public Api, public BitmapFlags {
+public:
+  BlendTable() {}
+
+  /*! \details Constructs a table that blends \a color into every
+   * color of \a palette for each coverage value of
+   * \a coverage_bits_per_pixel.
+   *
+   * The table is not valid if \a palette has more than 256 colors
+   * or \a color is not in \a palette.
+   */
+  BlendTable(
+    const Palette &palette,
+    sg_color_t color,
+    BitsPerPixel coverage_bits_per_pixel);
+
+  bool is_valid() const { return m_color_map.count() > 0; }
+
+  sg_color_t color() const { return m_color; }
+
+  BitsPerPixel coverage_bits_per_pixel() const {
+    return static_cast<BitsPerPixel>(m_coverage_bits_per_pixel);
+  }
+
+  u32 color_count() const {
+    return m_color_map.count() >> m_coverage_bits_per_pixel;
+  }
+
+  /*! \details Returns the color that is drawn when a pixel with
+   * \a coverage is drawn over \a background.
+   */
+  sg_color_t get(sg_color_t background, u32 coverage) const {
+    return m_color_map.at(
+      (background << m_coverage_bits_per_pixel) + coverage);
+  }
+
+  /*! \details Returns the table for use with the sgfx library. The
+   * table refers to data owned by this object.
+   */
+  sg_blend_table_t table() const {
+    sg_blend_table_t result = {};
+    result.coverage_bits_per_pixel = m_coverage_bits_per_pixel;
+    result.color_count = color_count();
+    result.color_map = m_color_map.data();
+    return result;
+  }
+
+  /*! \details Blends \a region of the coverage bitmap \a canvas
+   * onto \a dest at \a point.
+   */
+  const BlendTable &draw(
+    Bitmap &dest,
+    const Point &point,
+    const Bitmap &canvas,
+    const Region &region) const;
+
+private:
+  var::Vector<u8> m_color_map;
+  sg_color_t m_color = 0;
+  u8 m_coverage_bits_per_pixel = 0;
+};
+
+} // namespace ux::sgfx
+
+#endif // UXAPI_UX_SGFX_BLENDTABLE_HPP_
@@ -0,0 +1,97 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#ifndef UXAPI_UX_SGFX_CANVASCACHE_HPP_
+#define UXAPI_UX_SGFX_CANVASCACHE_HPP_
+
+#include <fs/File.hpp>
+#include <var/Vector.hpp>
+
+#include "Bitmap.hpp"
+
+namespace ux::sgfx {
+
+/*! \brief Canvas Cache Class
+ * \details This class keeps the most recently used font and
+ * icon font canvases in memory. All fonts share the cache.
+ *
+ * Canvases are identified by the font file and the offset of the
+ * canvas within the file. When the cached canvases would use more
+ * than the budget, the least recently used canvases are discarded.
+ * The most recently loaded canvas is always kept, even if it is
+ * larger than the budget.
+ *
+ * \code
+ * CanvasCache::set_budget(32 * 1024);
+ * // ... draw text
+ * printf("hits %ld misses %ld\n", CanvasCache::hit_count(),
+ *   CanvasCache::miss_count());
+ * \endcode
+ *
+ */
+class CanvasCache : public BitmapFlags {
+public:
+  /*! \details Returns the canvas at \a offset in \a file. The canvas is
+   * read from the file if it is not in the cache.
+   *
+   * The returned bitmap is valid until the next call to get().
+   */
+  static const Bitmap *get(
+    const fs::FileObject *file,
+    u32 offset,
+    const Area &area,
+    BitsPerPixel bits_per_pixel);
+
+  /*! \details Discards all the canvases that belong to \a file. */
+  static void remove(const fs::FileObject *file);
+
+  static void clear();
+
+  static void set_budget(size_t value);
+  static size_t budget() { return m_budget; }
+
+  /*! \details Returns the number of bytes used by cached canvases. */
+  static size_t calculate_size();
+
+  static u32 hit_count() { return m_hit_count; }
+  static u32 miss_count() { return m_miss_count; }
+  static void reset_statistics() {
+    m_hit_count = 0;
+    m_miss_count = 0;
+  }
+
+private:
+  class Entry {
+  public:
+    Entry(const fs::FileObject *file, u32 offset, BitmapData &&bitmap)
+      : m_file(file), m_offset(offset), m_bitmap(std::move(bitmap)) {}
+
+    bool is_match(const fs::FileObject *file, u32 offset) const {
+      return (m_file == file) && (m_offset == offset);
+    }
+
+    API_AF(Entry, u32, last_access, 0);
+
+  public:
+    const fs::FileObject *file() const { return m_file; }
+    const BitmapData &bitmap() const { return m_bitmap; }
+    size_t size() const { return m_bitmap.view().size(); }
+
+  private:
+    const fs::FileObject *m_file;
+    u32 m_offset;
+    BitmapData m_bitmap;
+  };
+
+  static var::Vector<Entry> m_entry_list;
+  static size_t m_budget;
+  static u32 m_access_count;
+  static u32 m_hit_count;
+  static u32 m_miss_count;
+
+  static void make_room(size_t size);
+  static void remove_entry(size_t offset);
+};
+
+} // namespace ux::sgfx
+
+#endif // UXAPI_UX_SGFX_CANVASCACHE_HPP_
@@ -12,6 +12,7 @@
 namespace ux::sgfx {
 
 class Font;
+class BlendTable;
 
 class FontFlags {
 public:
@@ -49,6 +50,13 @@ public:
     Info() {}
     Info(const var::StringView path);
 
+    /*! \details Constructs info for a font that is not named by a
+     * file path (such as a font in an asset pack). \a name must
+     * remain valid for the lifetime of the info.
+     */
+    Info(const var::StringView name, Style style, sg_size_t point_size)
+      : m_style(style), m_point_size(point_size), m_name(name) {}
+
     static bool ascending_point_size(const Info &a, const Info &b);
     static bool ascending_style(const Info &a, const Info &b);
 
@@ -60,11 +68,26 @@ public:
     API_AF(Info, Style, style, Style::any);
     API_AF(Info, sg_size_t, point_size, 0);
     API_AC(Info, var::PathString, file_path);
+    var::StringView m_name;
   };
 
   Font() {}
   Font(const fs::FileObject *file);
 
+  /*! \details Constructs a font that uses the contents of
+   * \a view in place (such as a memory-mapped font file or a
+   * font stored in memory-mapped flash).
+   *
+   * The view must remain valid for the lifetime of the font.
+   */
+  explicit Font(const var::View view) : Font(MemoryMap(view)) {}
+
+  /*! \details Constructs a font from a memory map. The character
+   * metrics, kerning pairs and canvases are used without being copied
+   * unless the canvases are not word aligned.
+   */
+  explicit Font(MemoryMap &&memory_map);
+
   Font(const Font &a) = delete;
   Font &operator=(const Font &a) = delete;
 
@@ -74,18 +97,113 @@ public:
     return *this;
   }
 
+  ~Font();
 
-  bool is_valid() const { return m_file != nullptr; }
+
+  bool is_valid() const {
+    return (m_file != nullptr) || (m_canvas_view.size() > 0);
+  }
+
+  /*! \details Returns true if the font is used in place (no copies
+   * are made of the font data).
+   */
+  bool is_zero_copy() const { return m_is_zero_copy; }
 
   static var::StringView ascii_character_set();
 
+  /*! \details Returns true if the font has a sparse unicode index
+   * rather than the printable ASCII characters.
+   */
+  bool is_unicode() const {
+    return (m_header.version & SG_FONT_VERSION_FLAG_IS_UNICODE) != 0;
+  }
+
+  /*! \details Returns true if the font canvases hold glyph coverage
+   * values that can be drawn anti-aliased with a BlendTable.
+   */
+  bool is_antialiased() const {
+    return (m_header.version & SG_FONT_VERSION_FLAG_IS_COVERAGE) != 0;
+  }
+
+  static constexpr u32 replacement_character() { return 0xfffd; }
+
+  /*! \details Decodes the UTF-8 code point that starts at \a offset
+   * in \a value and advances \a offset past it.
+   *
+   * Invalid sequences are decoded as replacement_character().
+   */
+  static u32 decode_utf8(const var::StringView value, size_t &offset);
+
   sg_size_t get_height() const;
   sg_size_t get_width() const;
 
   int offset_x() const { return m_char.offset_x; }
   int offset_y() const { return m_char.offset_y; }
   int get_width(const var::StringView str) const;
-  int size() const { return m_header.character_count; }
+
+  /*! \details Measures \a str in a single pass.
+   *
+   * Each entry of \a advance_list is assigned the position of the
+   * cursor (relative to the start of \a str) after the character
+   * that includes the byte at the same offset. Kerning is included
+   * as it is in draw(). The bytes of a multi-byte UTF-8 character
+   * all have the same value.
+   *
+   * At most \a count entries are assigned. The number of entries
+   * assigned is returned.
+   *
+   * The positions can be searched with find_fit() to break lines,
+   * truncate strings, and find the character at a point.
+   */
+  size_t measure(
+    const var::StringView str,
+    sg_int_t *advance_list,
+    size_t count) const;
+
+  /*! \details Returns the number of bytes at the start of a string
+   * that fit in \a width using the \a advance_list assigned by
+   * measure(). Multi-byte characters are never split.
+   */
+  static size_t
+  find_fit(const sg_int_t *advance_list, size_t count, sg_int_t width);
+
+  /*! \details Returns the region (relative to the point passed to
+   * draw()) that contains every pixel drawn for \a str.
+   *
+   * Glyphs can extend past their advance, so the bounds can differ
+   * from get_width() and get_height().
+   */
+  Region calculate_bounds(const var::StringView str) const;
+
+  /*! \details Returns the file or memory that holds the font.
+   * This identifies the font in the text run cache.
+   */
+  const void *source() const {
+    return m_file != nullptr ? static_cast<const void *>(m_file)
+                             : m_canvas_view.to_const_void();
+  }
+
+  /*! \details Returns the metrics for \a unicode or nullptr if the
+   * font does not have the character.
+   *
+   * The metrics of ASCII fonts are loaded when the font is created.
+   * Unicode fonts read from a file load the metrics in small pages
+   * the first time they are used, so the returned pointer is only
+   * valid until the next call.
+   */
+  const sg_font_char_t *find_character(u32 unicode) const;
+
+  /*! \details Returns how far the cursor advances for \a unicode (not
+   * including kerning).
+   */
+  int get_advance(u32 unicode) const {
+    if (unicode == ' ') {
+      return space_size();
+    }
+    const sg_font_char_t *ch = find_character(unicode);
+    return ch ? ch->advance_x : 0;
+  }
+  int size() const { return m_character_count; }
 
   Font &set_letter_spacing(sg_size_t spacing) {
     m_letter_spacing = spacing;
@@ -103,11 +221,24 @@ public:
     Bitmap &dest,
     const Point &point) const;
 
-  const Font &draw(char c, Bitmap &dest, const Point &point) const;
+  /*! \details Draws \a const_string using \a blend_table to blend
+   * the glyph coverage with the pixels of \a dest rather than
+   * using the pen of \a dest.
+   *
+   * The pen is used if the table does not match the bits per pixel
+   * of the font (see BlendTable::coverage_bits_per_pixel()).
+   */
+  const Font &draw(
+    const var::StringView const_string,
+    Bitmap &dest,
+    const Point &point,
+    const BlendTable &blend_table) const;
+
+  const Font &draw(u32 unicode, Bitmap &dest, const Point &point) const;
 
   const sg_font_char_t &character() const { return m_char; }
 
-  u16 character_count() const { return m_header.character_count; }
+  u32 character_count() const { return m_character_count; }
   u16 bits_per_pixel() const { return m_header.bits_per_pixel; }
   u16 kerning_pair_count() const { return m_header.kerning_pair_count; }
 
@@ -126,8 +257,6 @@ public:
 
 protected:
   const fs::FileObject *m_file = nullptr;
-  mutable BitmapData m_canvas;
-  mutable u8 m_current_canvas = 0;
   mutable sg_font_char_t m_char = {};
   bool m_is_kerning_enabled = true;
   sg_size_t m_letter_spacing = 1;
@@ -135,12 +264,39 @@ protected:
   sg_font_header_t m_header = {};
   u32 m_canvas_start = 0;
   u32 m_canvas_size = 0;
+  u32 m_character_start = 0;
+  u32 m_character_count = 0;
+  u32 m_range_count = 0;
+  // storage used when the font is not used in place
   var::Vector<sg_font_kerning_pair_t> m_kerning_pairs;
+  var::Vector<sg_font_char_t> m_character_list;
+  var::Vector<sg_font_unicode_range_t> m_range_list;
+  // sorted kerning pairs, character metrics and unicode ranges
+  const sg_font_kerning_pair_t *m_kerning_pair_data = nullptr;
+  const sg_font_char_t *m_character_data = nullptr;
+  const sg_font_unicode_range_t *m_range_data = nullptr;
+  // metrics of unicode fonts that are read from a file
+  struct CharacterPage {
+    u32 offset;
+    u32 last_access;
+    var::Vector<sg_font_char_t> list;
+  };
+  static constexpr u32 character_page_size = 32;
+  static constexpr u32 maximum_character_page_count = 8;
+  mutable var::Vector<CharacterPage> m_character_page_list;
+  mutable u32 m_character_page_access = 0;
+  // canvases of fonts constructed from memory
+  MemoryMap m_memory_map;
+  var::Data m_aligned_data;
+  var::View m_canvas_view;
+  bool m_is_zero_copy = false;
+  // dense table of kerning values (character_count x character_count)
+  var::Vector<s8> m_kerning_table;
+  // offset of the first sorted kerning pair for each character
+  var::Vector<u16> m_kerning_index;
 
   void swap(Font &a) {
     std::swap(m_file, a.m_file);
-    std::swap(m_canvas, a.m_canvas);
-    std::swap(m_current_canvas, a.m_current_canvas);
     std::swap(m_char, a.m_char);
     std::swap(m_is_kerning_enabled, a.m_is_kerning_enabled);
     std::swap(m_letter_spacing, a.m_letter_spacing);
@@ -148,19 +304,56 @@ protected:
     std::swap(m_header, a.m_header);
     std::swap(m_canvas_start, a.m_canvas_start);
     std::swap(m_canvas_size, a.m_canvas_size);
+    std::swap(m_character_start, a.m_character_start);
+    std::swap(m_character_count, a.m_character_count);
+    std::swap(m_range_count, a.m_range_count);
     std::swap(m_kerning_pairs, a.m_kerning_pairs);
+    std::swap(m_character_list, a.m_character_list);
+    std::swap(m_range_list, a.m_range_list);
+    std::swap(m_kerning_pair_data, a.m_kerning_pair_data);
+    std::swap(m_character_data, a.m_character_data);
+    std::swap(m_range_data, a.m_range_data);
+    std::swap(m_character_page_list, a.m_character_page_list);
+    std::swap(m_character_page_access, a.m_character_page_access);
+    std::swap(m_memory_map, a.m_memory_map);
+    std::swap(m_aligned_data, a.m_aligned_data);
+    std::swap(m_canvas_view, a.m_canvas_view);
+    std::swap(m_is_zero_copy, a.m_is_zero_copy);
+    std::swap(m_kerning_table, a.m_kerning_table);
+    std::swap(m_kerning_index, a.m_kerning_index);
   }
 
   void refresh();
-  static int to_charset(char ascii);
+  void build_kerning_index();
+  static int to_charset(u32 unicode);
+  static bool ascending_kerning_pair(
+    const sg_font_kerning_pair_t &a,
+    const sg_font_kerning_pair_t &b);
+
+  // glyphs are laid out and drawn in batches (one bit per glyph)
+  static constexpr u32 glyph_batch_size = 32;
 
   void draw_char_on_bitmap(
     const sg_font_char_t &ch,
     Bitmap &dest,
     const Point &point) const;
-  int load_char(sg_font_char_t &ch, char c, bool ascii) const;
+  void draw_string(
+    const var::StringView const_string,
+    Bitmap &dest,
+    const Point &point,
+    const sg_blend_table_t *blend_table) const;
+  void draw_glyph_batch(
+    const sg_glyph_t *glyph_list,
+    const u8 *canvas_list,
+    u32 count,
+    Bitmap &dest,
+    const sg_blend_table_t *blend_table) const;
+  bool load_canvas(u32 canvas_idx, Bitmap &canvas) const;
+  int find_character_offset(u32 unicode) const;
+  const sg_font_char_t *load_character(u32 offset) const;
+  const sg_font_char_t *load_character_page(u32 offset) const;
   sg_font_kerning_pair_t load_kerning(u32 offset) const;
-  int load_kerning(u16 first, u16 second) const;
+  int load_kerning(u32 first, u32 second) const;
 
 private:
 };
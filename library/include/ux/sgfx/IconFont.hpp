@@ -43,10 +43,18 @@ public:
     return *this;
   }
 
+  ~IconFont();
+
   bool is_valid() const { return m_file != nullptr; }
 
   IconFont &refresh();
 
+  /*! \details Returns a value that changes each time the icons are
+   * loaded by refresh(). Offsets returned by find() can be kept while
+   * the font and revision are the same.
+   */
+  u32 revision() const { return m_revision; }
+
   sg_size_t point_size() const { return m_header.max_height; }
 
   BitsPerPixel bits_per_pixel() const {
@@ -62,6 +70,12 @@ public:
     return IconInfo(m_list.at(offset % m_list.count()));
   }
 
+  /*! \details Returns the offset of the icon named \a name or
+   * count() if the font has no such icon.
+   *
+   * Names are hashed into a sorted index when the font is loaded, so
+   * the search compares hashes rather than strings.
+   */
   size_t find(const var::StringView  name) const;
 
   size_t count() const { return m_list.count(); }
@@ -72,18 +86,34 @@ public:
   const IconFont &draw(size_t offset, Bitmap &dest, const Point &point) const;
 
 private:
-  mutable s32 m_master_canvas_idx = -1;
   sg_font_icon_header_t m_header = {0};
-  mutable BitmapData m_master_canvas;
+  u32 m_canvas_size = 0;
   const fs::FileObject *m_file = nullptr;
   var::Vector<sg_font_icon_t> m_list;
+  u32 m_revision = 0;
+  // shared so fonts at the same address never repeat a revision
+  static u32 m_revision_count;
+
+  struct NameHash {
+    u32 hash;
+    u32 offset;
+  };
+
+  // sorted by hash
+  var::Vector<NameHash> m_name_index;
+
+  static u32 calculate_hash(const var::StringView name);
+  static bool is_less(const NameHash &a, const NameHash &b) {
+    return a.hash < b.hash;
+  }
 
   void swap(IconFont &a) {
-    std::swap(m_master_canvas_idx, a.m_master_canvas_idx);
     std::swap(m_header, a.m_header);
-    std::swap(m_master_canvas, a.m_master_canvas);
+    std::swap(m_canvas_size, a.m_canvas_size);
     std::swap(m_file, a.m_file);
     std::swap(m_list, a.m_list);
+    std::swap(m_revision, a.m_revision);
+    std::swap(m_name_index, a.m_name_index);
   }
 };
 
@@ -0,0 +1,66 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#ifndef UXAPI_UX_SGFX_MEMORYMAP_HPP_
+#define UXAPI_UX_SGFX_MEMORYMAP_HPP_
+
+#include <api/api.hpp>
+#include <var/Data.hpp>
+#include <var/StringView.hpp>
+#include <var/View.hpp>
+
+namespace ux::sgfx {
+
+/*! \brief Memory Map Class
+ * \details This class provides read-only access to the
+ * contents of an asset file.
+ *
+ * On hosts that support `mmap()`, the file is mapped
+ * and no heap is used. Otherwise, the file is read
+ * into memory once. Assets that are already memory-mapped
+ * (such as those in external flash) can be wrapped
+ * using a var::View.
+ *
+ */
+class MemoryMap : public api::ExecutionContext {
+public:
+  MemoryMap() {}
+  explicit MemoryMap(const var::StringView path);
+  explicit MemoryMap(const var::View view) : m_view(view) {}
+
+  MemoryMap(const MemoryMap &a) = delete;
+  MemoryMap &operator=(const MemoryMap &a) = delete;
+
+  MemoryMap(MemoryMap &&a) { swap(a); }
+  MemoryMap &operator=(MemoryMap &&a) {
+    swap(a);
+    return *this;
+  }
+
+  ~MemoryMap();
+
+  bool is_valid() const { return m_view.size() > 0; }
+
+  /*! \details Returns true if the file is mapped rather
+   * than copied into memory.
+   */
+  bool is_mapped() const { return m_address != nullptr; }
+
+  const var::View view() const { return m_view; }
+
+private:
+  var::View m_view;
+  void *m_address = nullptr;
+  size_t m_mapped_size = 0;
+  var::Data m_data;
+
+  void swap(MemoryMap &a) {
+    std::swap(m_view, a.m_view);
+    std::swap(m_address, a.m_address);
+    std::swap(m_mapped_size, a.m_mapped_size);
+    std::swap(m_data, a.m_data);
+  }
+};
+
+} // namespace ux::sgfx
+
+#endif // UXAPI_UX_SGFX_MEMORYMAP_HPP_
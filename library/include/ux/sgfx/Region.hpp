@@ -161,6 +161,46 @@ public:
     return result;
   }
 
+  /*! \details Returns the smallest region that contains this region
+   * and \a region.
+   */
+  Region calculate_bounds(const Region &region) const {
+    const Point top_left(
+      region.x() < x() ? region.x() : x(),
+      region.y() < y() ? region.y() : y());
+    const Point bottom_right(
+      region.end_point().x() > end_point().x() ? region.end_point().x()
+                                               : end_point().x(),
+      region.end_point().y() > end_point().y() ? region.end_point().y()
+                                               : end_point().y());
+    return Region(
+      top_left,
+      Area(bottom_right.x() - top_left.x(), bottom_right.y() - top_left.y()));
+  }
+
+  /*! \details Returns the part of \a region that is inside this
+   * region. Unlike overlap(), the result uses the same coordinates as
+   * both regions. The result is empty if the regions do not overlap.
+   */
+  Region calculate_intersection(const Region &region) const {
+    const Point top_left(
+      region.x() > x() ? region.x() : x(),
+      region.y() > y() ? region.y() : y());
+    const Point bottom_right(
+      region.end_point().x() < end_point().x() ? region.end_point().x()
+                                               : end_point().x(),
+      region.end_point().y() < end_point().y() ? region.end_point().y()
+                                               : end_point().y());
+    if (
+      (bottom_right.x() <= top_left.x())
+      || (bottom_right.y() <= top_left.y())) {
+      return Region();
+    }
+    return Region(
+      top_left,
+      Area(bottom_right.x() - top_left.x(), bottom_right.y() - top_left.y()));
+  }
+
 private:
   sg_region_t m_region;
 };
@@ -0,0 +1,101 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#ifndef UXAPI_UX_SGFX_RLEBITMAP_HPP_
+#define UXAPI_UX_SGFX_RLEBITMAP_HPP_
+
+#include "Bitmap.hpp"
+
+namespace ux::sgfx {
+
+/*! \brief Run-length Encoded Bitmap Class
+ * \details This class uses a run-length encoded bitmap
+ * (sg_rle_bmap_header_t followed by a row index and the runs)
+ * in place.
+ *
+ * The rows are validated once when the object is created. The bitmap
+ * is drawn without being decompressed using Bitmap::draw_bitmap() or
+ * Bitmap::draw_sub_bitmap(). Only the visible rows are decoded.
+ *
+ * \code
+ * MemoryMap map("/assets/background.srle");
+ * RleBitmap background(map.view());
+ * display_bitmap.draw_bitmap(Point(), background);
+ * \endcode
+ *
+ */
+class RleBitmap : public Api, public BitmapFlags {
+public:
+  RleBitmap() {}
+  explicit RleBitmap(const var::View view);
+
+  bool is_valid() const { return m_rle_bmap.row_offsets != nullptr; }
+
+  Area area() const { return Area(m_rle_bmap.area); }
+  sg_size_t width() const { return m_rle_bmap.area.width; }
+  sg_size_t height() const { return m_rle_bmap.area.height; }
+
+  BitsPerPixel bits_per_pixel() const {
+    return static_cast<BitsPerPixel>(m_rle_bmap.bits_per_pixel);
+  }
+
+  /*! \details Returns the encoded bitmap including the header. */
+  const var::View view() const { return m_view; }
+
+  const sg_rle_bmap_t *rle_bmap() const { return &m_rle_bmap; }
+
+  const RleBitmap &save(const fs::FileObject &file) const;
+
+protected:
+  void set_view(const var::View view);
+
+  void swap(RleBitmap &a) {
+    std::swap(m_view, a.m_view);
+    std::swap(m_rle_bmap, a.m_rle_bmap);
+  }
+
+private:
+  var::View m_view;
+  sg_rle_bmap_t m_rle_bmap = {};
+};
+
+/*! \brief Run-length Encoded Bitmap Data Class
+ * \details This class holds a run-length encoded bitmap
+ * in memory. It can be encoded from a Bitmap or loaded
+ * from a file.
+ *
+ * \code
+ * RleBitmapData compressed(bitmap);
+ * compressed.save(File(File::IsOverwrite::yes, "/assets/bitmap.srle"));
+ * \endcode
+ *
+ */
+class RleBitmapData : public RleBitmap {
+public:
+  RleBitmapData() {}
+  explicit RleBitmapData(const Bitmap &bitmap);
+
+  RleBitmapData(const RleBitmapData &a) = delete;
+  RleBitmapData &operator=(const RleBitmapData &a) = delete;
+
+  // the encoded data does not move so the view is already valid
+  RleBitmapData(RleBitmapData &&a) { swap(a); }
+
+  RleBitmapData &operator=(RleBitmapData &&a) {
+    swap(a);
+    return *this;
+  }
+
+  RleBitmapData &load(const fs::FileObject &file);
+
+private:
+  var::Data m_data;
+
+  void swap(RleBitmapData &a) {
+    std::swap(m_data, a.m_data);
+    RleBitmap::swap(a);
+  }
+};
+
+} // namespace ux::sgfx
+
+#endif // UXAPI_UX_SGFX_RLEBITMAP_HPP_
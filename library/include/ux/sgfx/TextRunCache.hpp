@@ -0,0 +1,124 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#ifndef UXAPI_UX_SGFX_TEXTRUNCACHE_HPP_
+#define UXAPI_UX_SGFX_TEXTRUNCACHE_HPP_
+
+#include <var/String.hpp>
+#include <var/Vector.hpp>
+
+#include "Font.hpp"
+
+namespace ux::sgfx {
+
+/*! \brief Text Run Cache Class
+ * \details This class keeps strings that have already been drawn
+ * as bitmaps so that they can be drawn again with a single
+ * Bitmap::draw_bitmap() call.
+ *
+ * Runs are drawn using the bits per pixel of the font, so they hold
+ * the glyph coverage rather than colors. The pen color is applied
+ * when the run is drawn, which means one run serves every color.
+ *
+ * Runs are identified by the font source, a hash of the string and
+ * the font settings that change how the string is drawn (space
+ * size and kerning). Each run keeps a copy of its string so that
+ * strings with the same hash are never confused. The least
+ * recently used runs are discarded when the runs use more than the
+ * budget.
+ *
+ * The cache is disabled until a budget is set.
+ *
+ * \code
+ * TextRunCache::set_budget(8 * 1024);
+ * // draw::Text now draws repeated strings from the cache
+ * \endcode
+ *
+ */
+class TextRunCache : public Api {
+public:
+  /*! \details Returns a bitmap with \a string drawn using \a font.
+   *
+   * \a offset is assigned the location of the bitmap relative to
+   * the point that would be passed to Font::draw(). nullptr is
+   * returned if the cache is disabled or the run cannot be created.
+   *
+   * The returned bitmap is valid until the next call to get().
+   */
+  static const Bitmap *
+  get(const Font &font, const var::StringView string, Point &offset);
+
+  /*! \details Discards all the runs that are drawn with the font
+   * identified by \a source (see Font::source()).
+   */
+  static void remove(const void *source);
+
+  static void clear();
+
+  static bool is_enabled() { return m_budget > 0; }
+
+  /*! \details Sets the number of bytes that can be used for runs.
+   * A value of zero disables the cache.
+   */
+  static void set_budget(size_t value);
+  static size_t budget() { return m_budget; }
+
+  /*! \details Returns the number of bytes used by cached runs. */
+  static size_t calculate_size();
+
+  static u32 hit_count() { return m_hit_count; }
+  static u32 miss_count() { return m_miss_count; }
+  static void reset_statistics() {
+    m_hit_count = 0;
+    m_miss_count = 0;
+  }
+
+private:
+  class Entry {
+  public:
+    Entry(
+      const void *source,
+      u64 key,
+      const var::StringView string,
+      const Point &offset,
+      BitmapData &&bitmap)
+      : m_source(source), m_key(key), m_string(string), m_offset(offset),
+        m_bitmap(std::move(bitmap)) {}
+
+    bool
+    is_match(const void *source, u64 key, const var::StringView string) const {
+      // the hash only rules runs out, the string must be compared
+      return (m_source == source) && (m_key == key) && (m_string == string);
+    }
+
+    API_AF(Entry, u32, last_access, 0);
+
+  public:
+    const void *source() const { return m_source; }
+    const Point &offset() const { return m_offset; }
+    const BitmapData &bitmap() const { return m_bitmap; }
+    size_t size() const {
+      return m_bitmap.view().size() + m_string.length();
+    }
+
+  private:
+    const void *m_source;
+    u64 m_key;
+    var::String m_string;
+    Point m_offset;
+    BitmapData m_bitmap;
+  };
+
+  static var::Vector<Entry> m_entry_list;
+  static size_t m_budget;
+  static u32 m_access_count;
+  static u32 m_hit_count;
+  static u32 m_miss_count;
+
+  static u64 calculate_key(const Font &font, const var::StringView string);
+  static void make_room(size_t size);
+  static void remove_entry(size_t offset);
+};
+
+} // namespace ux::sgfx
+
+#endif // UXAPI_UX_SGFX_TEXTRUNCACHE_HPP_
@@ -5,6 +5,7 @@
 
 #include "../Display.hpp"
 #include "Bitmap.hpp"
+#include "BlendTable.hpp"
 #include "Palette.hpp"
 
 namespace ux::sgfx {
@@ -94,6 +95,26 @@ public:
   const Theme &
   set_display_palette(const Display &display, Style style, State state) const;
 
+  /*! \details Creates a table for drawing anti-aliased text in
+   * text_color() using the palette of \a style and \a state.
+   */
+  BlendTable create_blend_table(
+    Style style,
+    State state,
+    BitsPerPixel coverage_bits_per_pixel) const;
+
+  /*! \details Returns a table for drawing anti-aliased text in
+   * text_color() using the palette of \a style and \a state.
+   *
+   * The most recently created tables are kept, so components can look
+   * up a table each time they draw. The table is valid until another
+   * table is created or the palettes are changed.
+   */
+  const BlendTable *get_blend_table(
+    Style style,
+    State state,
+    BitsPerPixel coverage_bits_per_pixel) const;
+
   static var::StringView get_state_name(State value);
   static var::StringView get_style_name(Style value);
 
@@ -130,6 +151,14 @@ private:
   header_t m_header = {};
   u16 m_color_count = 0;
 
+  struct BlendTableEntry {
+    u32 key;
+    BlendTable table;
+  };
+
+  static constexpr size_t maximum_blend_table_count = 4;
+  mutable var::Vector<BlendTableEntry> m_blend_table_list;
+
   size_t header_color_count() const { return 1 << (m_header.bits_per_pixel); }
 };
 
@@ -18,6 +18,11 @@ using namespace ux::sgfx;
 
 var::Vector<Assets::FontAsset> Assets::m_font_info_list;
 var::Vector<Assets::IconFontAsset> Assets::m_icon_font_info_list;
+fmt::AssetPack Assets::m_pack;
+u32 Assets::m_pack_font_offset = 0;
+u32 Assets::m_pack_icon_font_offset = 0;
+Assets::FindResult Assets::m_find_result_list[find_result_count] = {};
+u32 Assets::m_find_result_next = 0;
 
 #if defined NOT_BUILDING
 var::Vector<fmt::Svic> Assets::m_vector_path_list;
@@ -31,6 +36,12 @@ void Assets::initialize() {
     return;
   }
 
+  if (m_pack.is_valid()) {
+    // the pack index is already sorted
+    m_is_initialized = true;
+    return;
+  }
+
   var::Array<const char *, 3> asset_directories
     = var::Array(std::array{"/assets", "/home", "/home/assets"});
 
@@ -50,7 +61,113 @@ void Assets::initialize() {
   m_is_initialized = true;
 }
 
+void Assets::load_pack(const var::StringView path) {
+  API_RETURN_IF_ERROR();
+  if (m_pack.is_valid()) {
+    API_RETURN_ASSIGN_ERROR("asset pack is already loaded", EEXIST);
+  }
+
+  if (
+    is_any_created(m_font_info_list)
+    || is_any_created(m_icon_font_info_list)) {
+    // adding to the lists may move the fonts that are in use
+    API_RETURN_ASSIGN_ERROR("assets are already in use", EBUSY);
+  }
+
+  m_pack = fmt::AssetPack(path);
+  API_RETURN_IF_ERROR();
+
+  // the lists may move
+  clear_find_results();
+
+  m_pack_font_offset = m_font_info_list.count();
+  load_pack_fonts(fmt::AssetPack::Type::font, m_font_info_list);
+  m_pack_icon_font_offset = m_icon_font_info_list.count();
+  load_pack_fonts(fmt::AssetPack::Type::icon_font, m_icon_font_info_list);
+}
+
+template <class FontType>
+void Assets::load_pack_fonts(
+  fmt::AssetPack::Type type,
+  var::Vector<Asset<FontType>> &list) {
+  const int first = m_pack.find(type);
+  if (first < 0) {
+    return;
+  }
+
+  // entries of the same type are next to each other in the index
+  u32 last = first;
+  while ((last < m_pack.count()) && (m_pack.at(last).type() == type)) {
+    last++;
+  }
+
+  list.reserve(list.count() + last - first);
+  for (u32 i = first; i < last; i++) {
+    const fmt::AssetPack::Entry entry = m_pack.at(i);
+    list.vector().emplace_back(std::move(
+      Asset<FontType>()
+        .set_info(Font::Info(entry.name(), entry.style(), entry.point_size()))
+        .set_data(entry.data())));
+  }
+}
+
+template <class AssetType>
+bool Assets::is_any_created(const var::Vector<AssetType> &list) {
+  for (const AssetType &asset : list) {
+    if (asset.font().is_valid()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <class AssetType>
+AssetType *Assets::find_pack_font(
+  var::Vector<AssetType> &list,
+  u32 list_offset,
+  fmt::AssetPack::Type type,
+  const FindFont &options) {
+  if (m_pack.is_valid() == false || options.name().is_empty()) {
+    return nullptr;
+  }
+
+  const int offset = m_pack.find(
+    type,
+    options.name(),
+    type == fmt::AssetPack::Type::icon_font ? Font::Style::icons
+                                            : options.style(),
+    options.point_size());
+  if (offset < 0) {
+    return nullptr;
+  }
+
+  return &list.at(list_offset + offset - m_pack.find(type));
+}
+
+MappedBitmap Assets::find_bitmap(const var::StringView name) {
+  const int offset = m_pack.find(fmt::AssetPack::Type::bitmap, name);
+  if (offset < 0) {
+    return MappedBitmap();
+  }
+  return MappedBitmap(m_pack.at(offset).data());
+}
+
+VectorPath Assets::find_vector_icon(const var::StringView name) {
+  const int offset = m_pack.find(fmt::AssetPack::Type::vector_icon, name);
+  if (offset < 0) {
+    return VectorPath();
+  }
+
+  const var::View data = m_pack.at(offset).data();
+  sg_vector_path_t path = {};
+  path.icon.list = reinterpret_cast<const sg_vector_path_description_t *>(
+    data.to_const_u8());
+  path.icon.count = data.size() / sizeof(sg_vector_path_description_t);
+  return VectorPath(path);
+}
+
 void Assets::clear() {
+  clear_find_results();
   for (auto &entry : m_icon_font_info_list) {
     entry.destroy();
   }
@@ -74,6 +191,7 @@ void Assets::find_fonts_in_directory(const var::StringView path) {
     }
   }
 
+  clear_find_results();
   m_font_info_list.reserve(m_font_info_list.count() + entry_count);
   for (const auto &entry : file_list) {
     if (fs::Path::suffix(entry) == "sbf") {
@@ -97,6 +215,7 @@ void Assets::find_icons_in_directory(const var::StringView path) {
     }
   }
 
+  clear_find_results();
   m_icon_font_info_list.reserve(m_icon_font_info_list.count() + entry_count);
   for (const auto &entry : file_list) {
     if (fs::Path::suffix(entry) == "sbi") {
@@ -135,11 +254,89 @@ sgfx::VectorPath Assets::find_vector_path(const var::StringView name) {
 }
 #endif
 
+void *Assets::get_find_result(u8 flags, const FindFont &options) {
+  const FindResult key = create_find_result(flags, options);
+  for (const FindResult &result : m_find_result_list) {
+    if (
+      (result.asset != nullptr) && (result.name_hash == key.name_hash)
+      && (result.point_size == key.point_size) && (result.style == key.style)
+      && (result.flags == key.flags)) {
+      return result.asset;
+    }
+  }
+  return nullptr;
+}
+
+void Assets::set_find_result(
+  u8 flags,
+  const FindFont &options,
+  void *asset) {
+  // replace the oldest result
+  FindResult &result = m_find_result_list[m_find_result_next];
+  result = create_find_result(flags, options);
+  result.asset = asset;
+  m_find_result_next = (m_find_result_next + 1) % find_result_count;
+}
+
+void Assets::clear_find_results() {
+  for (FindResult &result : m_find_result_list) {
+    result.asset = nullptr;
+  }
+}
+
+Assets::FindResult
+Assets::create_find_result(u8 flags, const FindFont &options) {
+  // FNV-1a
+  u32 name_hash = 0x811c9dc5;
+  for (const char c : options.name()) {
+    name_hash = (name_hash ^ u8(c)) * 0x01000193;
+  }
+
+  FindResult result = {};
+  result.name_hash = name_hash;
+  result.point_size = options.point_size();
+  result.style = static_cast<u8>(options.style());
+  result.flags
+    = flags | (options.is_exact_match() ? find_result_flag_exact_match : 0);
+  return result;
+}
+
 const Assets::IconFontAsset *
 Assets::find_icon_font(const FindIconFont &options) {
 
   initialize();
 
+  IconFontAsset *found = static_cast<IconFontAsset *>(
+    get_find_result(find_result_flag_icon_font, options));
+  if (
+    (found != nullptr)
+    && (options.name().is_empty()
+        || (options.name() == found->info().get_name()))) {
+    return found->create();
+  }
+
+  const IconFontAsset *result = find_icon_font_in_list(options);
+  if (result != nullptr) {
+    set_find_result(
+      find_result_flag_icon_font,
+      options,
+      const_cast<IconFontAsset *>(result));
+  }
+  return result;
+}
+
+const Assets::IconFontAsset *
+Assets::find_icon_font_in_list(const FindIconFont &options) {
+
+  IconFontAsset *pack_entry = find_pack_font(
+    m_icon_font_info_list,
+    m_pack_icon_font_offset,
+    fmt::AssetPack::Type::icon_font,
+    options);
+  if (pack_entry != nullptr) {
+    return pack_entry->create();
+  }
+
   u8 closest_point_size = 0;
 
   // find point size and weight
@@ -179,6 +376,32 @@ const Assets::FontAsset *Assets::find_font(const FindFont &options) {
 
   initialize();
 
+  FontAsset *found = static_cast<FontAsset *>(get_find_result(0, options));
+  if (
+    (found != nullptr)
+    && (options.name().is_empty()
+        || (options.name() == found->info().get_name()))) {
+    return found->create();
+  }
+
+  const FontAsset *result = find_font_in_list(options);
+  if (result != nullptr) {
+    set_find_result(0, options, const_cast<FontAsset *>(result));
+  }
+  return result;
+}
+
+const Assets::FontAsset *Assets::find_font_in_list(const FindFont &options) {
+
+  FontAsset *pack_entry = find_pack_font(
+    m_font_info_list,
+    m_pack_font_offset,
+    fmt::AssetPack::Type::font,
+    options);
+  if (pack_entry != nullptr) {
+    return pack_entry->create();
+  }
+
   u8 closest_point_size = 0;
   Font::Style closest_style = Font::Style::any;
 
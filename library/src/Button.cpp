@@ -22,6 +22,7 @@ void Button::draw(const DrawingScaledAttributes &attributes) {
       font_name().is_empty() ? theme()->primary_font_name() : font_name())
     .set_value(value())
     .set_color(theme()->text_color())
+    .set_blend_theme(theme(), theme_style(), theme_state())
     .set_alignment(alignment())
     .draw(
       attributes + region_inside_padding.point()
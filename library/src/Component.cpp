@@ -8,6 +8,20 @@
 using namespace ux::sgfx;
 using namespace ux;
 
+namespace {
+u64 mix_hash(u64 hash, u64 value) {
+  return (hash ^ value) * 0x9E3779B97F4A7C15ULL;
+}
+
+u64 calculate_palette_hash(const Palette &palette) {
+  u64 result = u64(palette.pixel_format());
+  for (const sg_color_t color : palette.colors()) {
+    result = mix_hash(result, color);
+  }
+  return result;
+}
+} // namespace
+
 EventLoop *Component::m_event_loop = nullptr;
 
 Component::~Component() { set_visible_examine(false); }
@@ -23,6 +37,7 @@ void Component::examine_visibility() {
     }
 
     m_reference_drawing_attributes.set_bitmap(display()->bitmap());
+    invalidate_refresh();
 
     // local bitmap is a small section of the reference bitmap
     m_reference_drawing_attributes.calculate_area_on_bitmap();
@@ -48,6 +63,25 @@ void Component::examine_visibility() {
 }
 
 void Component::set_refresh_drawing_pending() {
+  m_damage_region = Region();
+  m_flags |= (flag_refresh_drawing_pending);
+  if (parent()) {
+    parent()->set_refresh_drawing_pending();
+  }
+}
+
+void Component::set_refresh_drawing_pending(const sgfx::Region &region) {
+  if (region.width() * region.height() == 0) {
+    return;
+  }
+
+  if (is_refresh_drawing_pending() == false) {
+    m_damage_region = region;
+  } else if (m_damage_region.width() * m_damage_region.height() > 0) {
+    // write the bounds of both regions
+    m_damage_region = m_damage_region.calculate_bounds(region);
+  }
+
   m_flags |= (flag_refresh_drawing_pending);
   if (parent()) {
     parent()->set_refresh_drawing_pending();
@@ -74,24 +108,54 @@ DrawingPoint Component::translate_point(const sgfx::Point &point) {
 void Component::refresh_drawing() {
   if (is_ready_to_draw()) {
     // use the palette if it is available
-    theme()->set_display_palette(*display(), m_theme_style, m_theme_state);
+    const Palette &palette
+      = theme()->read_palette(m_theme_style, m_theme_state);
+    display()->set_palette(palette);
 
     Region window_region = Region(
       Point(m_reference_drawing_attributes.calculate_point_on_bitmap())
         + m_refresh_region.point(),
       m_refresh_region.area());
 
-    if (window_region.width() * window_region.height() > 0) {
-      display()->set_window(window_region);
+    if (m_damage_region.width() * m_damage_region.height() > 0) {
+      // only part of the component changed
+      const Region damage_region
+        = m_refresh_region.calculate_intersection(m_damage_region);
+      m_damage_region = Region();
+      if (damage_region.width() * damage_region.height() > 0) {
+        // the hash no longer matches what is on the display
+        m_refresh_hash = 0;
+        display()->set_window(Region(
+          Point(m_reference_drawing_attributes.calculate_point_on_bitmap())
+            + damage_region.point(),
+          damage_region.area()));
+        display()->write_bitmap(
+          Bitmap(m_local_bitmap).set_offset(damage_region.point()));
+      }
+    } else if (window_region.width() * window_region.height() > 0) {
+      // the same pixels in the same window with the same palette
+      // do not need to be written again
+      u64 refresh_hash = m_local_bitmap.calculate_hash(m_refresh_region);
+      refresh_hash = mix_hash(
+        refresh_hash,
+        (u64(u16(window_region.x())) << 48)
+          | (u64(u16(window_region.y())) << 32)
+          | (u64(window_region.width()) << 16) | window_region.height());
+      refresh_hash = mix_hash(refresh_hash, calculate_palette_hash(palette));
+
+      if (refresh_hash != m_refresh_hash) {
+        m_refresh_hash = refresh_hash;
+        display()->set_window(window_region);
 
 #if 0
-      printer::Printer p;
-      p.object("draw " | name(), window_region);
-      p.object("refreshRegion " | name(), m_refresh_region);
+        printer::Printer p;
+        p.object("draw " | name(), window_region);
+        p.object("refreshRegion " | name(), m_refresh_region);
 #endif
 
-      display()->write_bitmap(
-        Bitmap(m_local_bitmap).set_offset(m_refresh_region.point()));
+        display()->write_bitmap(
+          Bitmap(m_local_bitmap).set_offset(m_refresh_region.point()));
+      }
     }
 
     clear_refresh_drawing_pending();
@@ -124,6 +188,12 @@ void Component::erase() {
       display()->set_window(window_region);
       display()->clear();
     }
+    invalidate_refresh();
+
+    // siblings under the erased region must be written again
+    if (parent()) {
+      parent()->invalidate_refresh_region(window_region);
+    }
   }
 }
 
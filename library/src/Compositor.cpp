@@ -0,0 +1,155 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include <cstring>
+
+#include "ux/Compositor.hpp"
+#include "ux/sgfx/BitmapDiff.hpp"
+
+using namespace ux::sgfx;
+using namespace ux;
+
+Compositor::Compositor(
+  const Area &area,
+  Bitmap::BitsPerPixel bits_per_pixel)
+  : m_bitmap(area, bits_per_pixel), m_window(Point(), area) {
+  m_bitmap.clear();
+  m_damage_list.reserve(16);
+  m_written_list.reserve(maximum_written_count);
+}
+
+Compositor &Compositor::write_bitmap(const Bitmap &bitmap) {
+  const sg_point_t offset = bitmap.bmap()->offset;
+  const Region source_region(Point(offset.x, offset.y), m_window.area());
+
+  if (is_diff() && is_written(m_window)) {
+    m_previous.resize(m_window.area(), m_bitmap.bits_per_pixel());
+    m_previous.set_pen(Pen()).draw_sub_bitmap(Point(), m_bitmap, m_window);
+    m_current.resize(m_window.area(), m_bitmap.bits_per_pixel());
+    m_current.set_pen(Pen()).draw_sub_bitmap(Point(), bitmap, source_region);
+    m_bitmap.set_pen(Pen()).draw_bitmap(m_window.point(), m_current);
+
+    // merging is worthwhile while it adds fewer bytes than a window
+    const BitmapDiff diff(
+      m_previous,
+      m_current,
+      BitmapDiff::Options().set_merge_cost(
+        transaction_cost() * 8 / static_cast<u32>(m_bitmap.bits_per_pixel())));
+    for (const Region &region : diff.region_list()) {
+      add_damage(Region(m_window.point() + region.point(), region.area()));
+    }
+    return *this;
+  }
+
+  m_bitmap.set_pen(Pen()).draw_sub_bitmap(
+    m_window.point(),
+    bitmap,
+    source_region);
+  add_written(m_window);
+  return add_damage(m_window);
+}
+
+Compositor &Compositor::clear() {
+  m_bitmap.clear_rectangle(m_window);
+  add_written(m_window);
+  return add_damage(m_window);
+}
+
+Compositor &Compositor::add_damage(const Region &region) {
+  Region damage = m_bitmap.region().calculate_intersection(region);
+  if (damage.width() * damage.height() == 0) {
+    return *this;
+  }
+
+  m_damage_count++;
+  const u16 palette = m_palette_list.count();
+  // merge with the region that saves the most until no merge saves
+  // anything; the merged region may then be worth merging with another
+  while (true) {
+    size_t best_offset = 0;
+    s32 best_saving = -1;
+    for (size_t i = 0; i < m_damage_list.count(); i++) {
+      const Damage &item = m_damage_list.at(i);
+      if (item.palette() != palette) {
+        // the regions are sent with different palettes
+        continue;
+      }
+      const s32 saving
+        = s32(calculate_cost(item.region()) + calculate_cost(damage))
+          - s32(calculate_cost(item.region().calculate_bounds(damage)));
+      if (saving > best_saving) {
+        best_saving = saving;
+        best_offset = i;
+      }
+    }
+
+    if (best_saving < 0) {
+      break;
+    }
+
+    damage = m_damage_list.at(best_offset).region().calculate_bounds(damage);
+    m_damage_list.at(best_offset) = m_damage_list.back();
+    m_damage_list.pop_back();
+  }
+
+  m_damage_list.push_back(Damage().set_region(damage).set_palette(palette));
+  return *this;
+}
+
+Compositor &Compositor::set_palette(const Palette &palette) {
+  // the palette in effect is kept across frames so setting the same
+  // palette before each write does not send the windows again
+  if (
+    m_is_palette_valid && (m_palette.pixel_format() == palette.pixel_format())
+    && (m_palette.colors().count() == palette.colors().count())
+    && (memcmp(
+          m_palette.colors().to_const_void(),
+          palette.colors().to_const_void(),
+          palette.colors().count() * sizeof(sg_color_t))
+        == 0)) {
+    return *this;
+  }
+
+  m_palette = palette;
+  m_is_palette_valid = true;
+  m_palette_revision++;
+  if (is_frame()) {
+    m_palette_list.push_back(palette);
+  }
+  return *this;
+}
+
+u32 Compositor::calculate_cost(const Region &region) const {
+  return transaction_cost()
+         + (u32(region.width()) * region.height()
+              * static_cast<u32>(m_bitmap.bits_per_pixel())
+            + 7)
+             / 8;
+}
+
+bool Compositor::is_written(const Region &region) const {
+  for (const Written &item : m_written_list) {
+    if (item.palette_revision != m_palette_revision) {
+      continue;
+    }
+    const Region overlap = item.region.calculate_intersection(region);
+    if (
+      (overlap.width() == region.width())
+      && (overlap.height() == region.height())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Compositor::add_written(const Region &region) {
+  const Region written = m_bitmap.region().calculate_intersection(region);
+  if ((written.width() * written.height() == 0) || is_written(written)) {
+    return;
+  }
+
+  // the oldest window is forgotten when the list is full
+  if (m_written_list.count() == maximum_written_count) {
+    m_written_list.remove(0);
+  }
+  m_written_list.push_back({written, m_palette_revision});
+}
@@ -15,6 +15,10 @@ void Controller::transition(Layout &next_component) {
 }
 
 void Controller::distribute_event(const ux::Event &event) {
+  // everything drawn for the event is sent to the display at once
+  Display *display = m_event_loop.display();
+  display->begin_frame();
+
   handle_event(event);
 
   if (m_current_layout) {
@@ -40,6 +44,8 @@ void Controller::distribute_event(const ux::Event &event) {
     m_current_layout->set_enabled_examine(true);
     m_current_layout->set_visible_examine(true);
   }
+
+  display->end_frame();
 }
 
 void Controller::refresh_drawing(Layout *layout) {
@@ -1,17 +1,21 @@
 // Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
 
+#include <cstring>
+
 #include "ux/Display.hpp"
-#include "fs/ViewFile.hpp"
 #include "var/StringView.hpp"
 
 using namespace ux;
-using namespace fs;
 using namespace var;
 
-// const Display &Display::write(const sgfx::Bitmap &bitmap) const {}
-
 Display::Display(var::StringView path)
-  : fs::FileMemberAccess<Display, fs::File>(path) {
+  : m_file_device(path), m_device(&m_file_device) {
+  initialize();
+}
+
+Display::Display(DisplayDevice &device) : m_device(&device) { initialize(); }
+
+void Display::initialize() {
   Info info = get_info();
 
   set_bitmap(sgfx::Bitmap(
@@ -21,62 +25,155 @@ Display::Display(var::StringView path)
       info.height() - info.margin_top() - info.margin_bottom()),
     info.bits_per_pixel()));
 
-  display_attr_t attr;
+  display_attr_t attr = {};
   attr.o_flags = DISPLAY_FLAG_INIT;
-  ioctl(I_DISPLAY_SETATTR, &attr);
+  m_device->set_attributes(attr);
+  invalidate_state();
+}
+
+const Display &Display::begin_frame() const {
+  if (m_compositor) {
+    m_compositor->begin_frame();
+  }
+  return *this;
+}
+
+const Display &Display::end_frame() const {
+  if (m_compositor && m_compositor->end_frame()) {
+    flush();
+  }
+  return *this;
+}
+
+void Display::flush() const {
+  if (m_compositor->is_damaged() == false) {
+    return;
+  }
+
+  // each palette is sent before the windows that were written with it
+  const var::Vector<Compositor::Damage> &damage_list
+    = m_compositor->damage_list();
+  const var::Vector<sgfx::Palette> &palette_list
+    = m_compositor->palette_list();
+  for (size_t palette = 0; palette <= palette_list.count(); palette++) {
+    if (palette > 0) {
+      set_device_palette(palette_list.at(palette - 1));
+    }
+
+    for (const Compositor::Damage &damage : damage_list) {
+      if (damage.palette() == palette) {
+        const sgfx::Region &region = damage.region();
+        set_device_window(region);
+        m_device->write_bitmap(
+          sgfx::Bitmap(m_compositor->bitmap()).set_offset(region.point()));
+      }
+    }
+  }
+  m_compositor->clear_damage();
 }
 
 const Display &Display::write_bitmap(const sgfx::Bitmap &bitmap) const {
-  return write(View(*bitmap.bmap()));
+  if (m_compositor) {
+    m_compositor->write_bitmap(bitmap);
+    if (m_compositor->is_frame() == false) {
+      flush();
+    }
+    return *this;
+  }
+
+  m_device->write_bitmap(bitmap);
+  return *this;
 }
 
 Display::Info Display::get_info() const {
-  display_info_t info;
-  ioctl(I_DISPLAY_GETINFO, &info);
-  return Display::Info(info);
+  return Display::Info(m_device->get_info());
 }
 
 const Display &Display::set_window(const sgfx::Region &region) const {
-  display_attr_t attr;
+  if (m_compositor) {
+    // the compositor sends the window when it is flushed
+    m_compositor->set_window(region);
+    return *this;
+  }
+
+  set_device_window(region);
+  return *this;
+}
+
+void Display::set_device_window(const sgfx::Region &region) const {
+  if (
+    m_state.is_window_valid && (m_state.window.point() == region.point())
+    && (m_state.window.area() == region.area())) {
+    m_state.skipped_window_count++;
+    return;
+  }
+
+  display_attr_t attr = {};
   attr.o_flags = DISPLAY_FLAG_SET_WINDOW;
   attr.window_x = region.point().x();
   attr.window_y = region.point().y();
   attr.window_width = region.area().width();
   attr.window_height = region.area().height();
-  return ioctl(I_DISPLAY_SETATTR, &attr);
+  m_device->set_attributes(attr);
+  m_state.window = region;
+  m_state.is_window_valid = is_success();
 }
 
 const Display &Display::set_mode(Mode value) const {
-  display_attr_t attr;
+  display_attr_t attr = {};
   attr.o_flags = DISPLAY_FLAG_SET_MODE;
   if (value == Mode::palette) {
     attr.o_flags |= DISPLAY_FLAG_IS_MODE_PALETTE;
   } else {
     attr.o_flags |= DISPLAY_FLAG_IS_MODE_RAW;
   }
-  return ioctl(I_DISPLAY_SETATTR, &attr);
+
+  if (attr.o_flags == m_state.mode_flags) {
+    m_state.skipped_mode_count++;
+    return *this;
+  }
+
+  m_device->set_attributes(attr);
+  m_state.mode_flags = is_success() ? attr.o_flags : 0;
+  return *this;
 }
 
 const Display &Display::enable() const {
-  display_attr_t attributes;
+  display_attr_t attributes = {};
   attributes.o_flags = DISPLAY_FLAG_ENABLE;
-  return ioctl(I_DISPLAY_CLEAR, &attributes);
+  m_device->set_attributes(attributes);
+  return *this;
 }
 
 const Display &Display::clear() const {
-  display_attr_t attributes;
+  if (m_compositor) {
+    m_compositor->clear();
+    if (m_compositor->is_frame() == false) {
+      flush();
+    }
+    return *this;
+  }
+
+  display_attr_t attributes = {};
   attributes.o_flags = DISPLAY_FLAG_CLEAR;
-  return ioctl(I_DISPLAY_CLEAR, &attributes);
+  m_device->set_attributes(attributes);
+  return *this;
 }
 
 const Display &Display::disable() const {
-  display_attr_t attributes;
+  display_attr_t attributes = {};
   attributes.o_flags = DISPLAY_FLAG_DISABLE;
-  return ioctl(I_DISPLAY_CLEAR, &attributes);
+  m_device->set_attributes(attributes);
+  return *this;
 }
 
 const Display &Display::refresh() const {
-  return ioctl(I_DISPLAY_REFRESH);
+  if (m_compositor) {
+    // pixels written so far are part of the refresh
+    flush();
+  }
+  m_device->refresh();
+  return *this;
 }
 
 const Display &Display::wait(const chrono::MicroTime &resolution) const {
@@ -86,21 +183,54 @@ const Display &Display::wait(const chrono::MicroTime &resolution) const {
   return *this;
 }
 
-bool Display::is_busy() const {
-  return ioctl(I_DISPLAY_ISBUSY).return_value() > 0;
-}
+bool Display::is_busy() const { return m_device->is_busy(); }
 
 const Display &Display::set_palette(const sgfx::Palette &palette) const {
-  display_palette_t display_palette;
+  if (m_compositor) {
+    // the compositor keeps the palette that its windows are sent with
+    m_compositor->set_palette(palette);
+    if (m_compositor->is_frame()) {
+      // the compositor sends the palette after the writes before it
+      return *this;
+    }
+  }
+
+  set_device_palette(palette);
+  return *this;
+}
+
+void Display::set_device_palette(const sgfx::Palette &palette) const {
+  const u8 pixel_format = static_cast<u8>(palette.pixel_format());
+  const var::Vector<sg_color_t> &colors = palette.colors();
+  if (
+    m_state.is_palette_valid && (m_state.palette_pixel_format == pixel_format)
+    && (m_state.palette_colors.count() == colors.count())
+    && (memcmp(
+          m_state.palette_colors.to_const_void(),
+          colors.to_const_void(),
+          colors.count() * sizeof(sg_color_t))
+        == 0)) {
+    m_state.skipped_palette_count++;
+    return;
+  }
+
+  display_palette_t display_palette = {};
   display_palette.pixel_format = static_cast<u8>(palette.pixel_format());
   display_palette.count = palette.colors().count();
   display_palette.colors = (void *)palette.colors().to_const_void();
-  return ioctl(I_DISPLAY_SETPALETTE, &display_palette);
+  m_device->set_palette(display_palette);
+
+  // the colors are copied so they can be compared with the next palette
+  m_state.is_palette_valid = is_success();
+  m_state.palette_pixel_format = pixel_format;
+  m_state.palette_colors.resize(colors.count());
+  for (size_t i = 0; i < colors.count(); i++) {
+    m_state.palette_colors.at(i) = colors.at(i);
+  }
 }
 
 sgfx::Palette Display::get_palette() const {
-  display_palette_t display_palette;
-  ioctl(I_DISPLAY_GETPALETTE, &display_palette);
+  const display_palette_t display_palette = m_device->get_palette();
   API_RETURN_VALUE_IF_ERROR(sgfx::Palette());
 
   // copy colors from display_palette_t
@@ -1,11 +1,50 @@
-// Copyright 2011-2020 Tyler Gilbert and Stratify Labs, Inc; see
-// LICENSE.md for rights.
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
 
 #include "ux/DisplayDevice.hpp"
 
 using namespace ux;
 
-DisplayDevice::DisplayDevice() {}
+FileDisplayDevice::FileDisplayDevice(const var::StringView path)
+  : m_file(path, fs::OpenMode::read_write()) {}
 
-DisplayDevice::DisplayDevice(const var::StringView path)
-  : m_device(path, fs::OpenMode::read_write()) {}
+display_info_t FileDisplayDevice::interface_get_info() const {
+  display_info_t info = {};
+  m_file.ioctl(I_DISPLAY_GETINFO, &info);
+  return info;
+}
+
+void FileDisplayDevice::interface_set_attributes(
+  const display_attr_t &attributes) {
+  display_attr_t value = attributes;
+  // the driver enables, clears, and disables using I_DISPLAY_CLEAR
+  const u32 clear_flags
+    = DISPLAY_FLAG_ENABLE | DISPLAY_FLAG_CLEAR | DISPLAY_FLAG_DISABLE;
+  m_file.ioctl(
+    (value.o_flags & clear_flags) ? I_DISPLAY_CLEAR : I_DISPLAY_SETATTR,
+    &value);
+}
+
+void FileDisplayDevice::interface_write_bitmap(const sgfx::Bitmap &bitmap) {
+  // the driver reads the pixels using the bitmap structure
+  m_file.write(var::View(*bitmap.bmap()));
+}
+
+void FileDisplayDevice::interface_refresh() {
+  m_file.ioctl(I_DISPLAY_REFRESH);
+}
+
+bool FileDisplayDevice::interface_is_busy() const {
+  return m_file.ioctl(I_DISPLAY_ISBUSY).return_value() > 0;
+}
+
+void FileDisplayDevice::interface_set_palette(
+  const display_palette_t &palette) {
+  display_palette_t value = palette;
+  m_file.ioctl(I_DISPLAY_SETPALETTE, &value);
+}
+
+display_palette_t FileDisplayDevice::interface_get_palette() const {
+  display_palette_t result = {};
+  m_file.ioctl(I_DISPLAY_GETPALETTE, &result);
+  return result;
+}
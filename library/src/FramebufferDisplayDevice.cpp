@@ -0,0 +1,93 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include "ux/FramebufferDisplayDevice.hpp"
+
+using namespace ux::sgfx;
+using namespace ux;
+
+FramebufferDisplayDevice::FramebufferDisplayDevice(
+  const Area &area,
+  Bitmap::BitsPerPixel bits_per_pixel)
+  : m_bitmap(area, bits_per_pixel), m_window(Point(), area) {
+  m_bitmap.clear();
+}
+
+display_info_t FramebufferDisplayDevice::interface_get_info() const {
+  display_info_t result = {};
+  result.width = m_bitmap.width();
+  result.height = m_bitmap.height();
+  result.cols = m_bitmap.width();
+  result.rows = m_bitmap.height();
+  result.bits_per_pixel = static_cast<u8>(m_bitmap.bits_per_pixel());
+  return result;
+}
+
+void FramebufferDisplayDevice::interface_set_attributes(
+  const display_attr_t &attributes) {
+  m_attribute_count++;
+  const u32 o_flags = attributes.o_flags;
+
+  if (o_flags & DISPLAY_FLAG_INIT) {
+    m_window = m_bitmap.region();
+    m_bitmap.clear();
+  }
+
+  if (o_flags & DISPLAY_FLAG_SET_WINDOW) {
+    m_window = Region(
+      Point(attributes.window_x, attributes.window_y),
+      Area(attributes.window_width, attributes.window_height));
+  }
+
+  if (o_flags & DISPLAY_FLAG_SET_MODE) {
+    m_is_palette_mode = (o_flags & DISPLAY_FLAG_IS_MODE_PALETTE) != 0;
+  }
+
+  if (o_flags & DISPLAY_FLAG_ENABLE) {
+    m_is_enabled = true;
+  }
+
+  if (o_flags & DISPLAY_FLAG_DISABLE) {
+    m_is_enabled = false;
+  }
+
+  if (o_flags & DISPLAY_FLAG_CLEAR) {
+    m_bitmap.clear_rectangle(m_window);
+  }
+}
+
+void FramebufferDisplayDevice::interface_write_bitmap(const Bitmap &bitmap) {
+  m_write_count++;
+  m_write_size += calculate_window_size();
+
+  // the window-sized part of the bitmap starts at its offset
+  const sg_point_t offset = bitmap.bmap()->offset;
+  m_bitmap.set_pen(Pen()).draw_sub_bitmap(
+    m_window.point(),
+    bitmap,
+    Region(Point(offset.x, offset.y), m_window.area()));
+}
+
+void FramebufferDisplayDevice::interface_set_palette(
+  const display_palette_t &palette) {
+  const sg_color_t *colors = static_cast<const sg_color_t *>(palette.colors);
+  m_palette_pixel_format = palette.pixel_format;
+  m_palette_colors.resize(palette.count);
+  for (u32 i = 0; i < palette.count; i++) {
+    m_palette_colors.at(i) = colors[i];
+  }
+}
+
+display_palette_t FramebufferDisplayDevice::interface_get_palette() const {
+  display_palette_t result = {};
+  result.pixel_format = m_palette_pixel_format;
+  result.count = m_palette_colors.count();
+  result.colors = (void *)m_palette_colors.to_const_void();
+  return result;
+}
+
+u32 FramebufferDisplayDevice::calculate_window_size() const {
+  return (u32(m_window.width()) * m_window.height()
+          * static_cast<u32>(m_bitmap.bits_per_pixel())
+          + 7)
+         / 8;
+}
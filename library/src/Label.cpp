@@ -21,6 +21,7 @@ void Label::draw(const DrawingScaledAttributes &attributes) {
       font_name().is_empty() ? theme()->primary_font_name() : font_name())
     .set_value(get_model())
     .set_color(theme()->text_color())
+    .set_blend_theme(theme(), theme_style(), theme_state())
     .set_alignment(alignment())
     .draw(
       attributes + region_inside_padding.point()
@@ -92,6 +92,31 @@ void Layout::erase_region(DrawingRegion region) {
     display()->set_window(window_region);
     display()->clear();
   }
+
+  // components under the erased region must be written again
+  invalidate_refresh();
+}
+
+void Layout::invalidate_refresh() {
+  Component::invalidate_refresh();
+  for (Item &item : m_component_list) {
+    if (item.component()) {
+      item.component()->invalidate_refresh();
+    }
+  }
+}
+
+void Layout::invalidate_refresh_region(const sgfx::Region &region) {
+  for (Item &item : m_component_list) {
+    Component *component = item.component();
+    if (component && component->is_ready_to_draw()) {
+      const sgfx::Region overlap
+        = component->region().calculate_intersection(region);
+      if (overlap.width() * overlap.height() > 0) {
+        component->invalidate_refresh();
+      }
+    }
+  }
 }
 
 Layout &Layout::add_component(Component &component) {
@@ -21,6 +21,7 @@ void ListItem::draw(const DrawingScaledAttributes &attributes) {
     .set_text_font_name(theme()->primary_font_name())
     .set_value(label())
     .set_color(theme()->text_color())
+    .set_blend_theme(theme(), theme_style(), theme_state())
     .set_align_left()
     .set_align_middle()
     .draw(
@@ -32,6 +33,7 @@ void ListItem::draw(const DrawingScaledAttributes &attributes) {
     .set_text_font_name(theme()->primary_font_name())
     .set_value(value())
     .set_color(theme()->text_color())
+    .set_blend_theme(theme(), theme_style(), theme_state())
     .set_align_right()
     .set_align_middle()
     .draw(
@@ -0,0 +1,75 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include "ux/SimulatedDisplayDevice.hpp"
+
+using namespace ux;
+
+SimulatedDisplayDevice::SimulatedDisplayDevice(const Construct &options)
+  : FramebufferDisplayDevice(options.area(), options.bits_per_pixel()),
+    m_construct(options) {
+  m_clock.start();
+}
+
+display_info_t SimulatedDisplayDevice::interface_get_info() const {
+  display_info_t result = FramebufferDisplayDevice::interface_get_info();
+  const u32 latency = m_construct.refresh_latency().microseconds();
+  result.freq = latency ? 1000000UL / latency : 0;
+  return result;
+}
+
+void SimulatedDisplayDevice::interface_set_attributes(
+  const display_attr_t &attributes) {
+  wait_until_ready();
+  transfer(m_construct.command_size());
+  FramebufferDisplayDevice::interface_set_attributes(attributes);
+}
+
+void SimulatedDisplayDevice::interface_write_bitmap(
+  const sgfx::Bitmap &bitmap) {
+  wait_until_ready();
+  transfer(m_construct.command_size() + calculate_window_size());
+  FramebufferDisplayDevice::interface_write_bitmap(bitmap);
+}
+
+void SimulatedDisplayDevice::interface_refresh() {
+  wait_until_ready();
+  transfer(m_construct.command_size());
+  FramebufferDisplayDevice::interface_refresh();
+  m_busy_until = m_clock.micro_time() + m_construct.refresh_latency();
+}
+
+bool SimulatedDisplayDevice::interface_is_busy() const {
+  if (m_clock.micro_time() < m_busy_until) {
+    m_busy_count++;
+    return true;
+  }
+  return false;
+}
+
+void SimulatedDisplayDevice::interface_set_palette(
+  const display_palette_t &palette) {
+  wait_until_ready();
+  transfer(m_construct.command_size() + palette.count * sizeof(sg_color_t));
+  FramebufferDisplayDevice::interface_set_palette(palette);
+}
+
+void SimulatedDisplayDevice::wait_until_ready() {
+  const chrono::MicroTime now = m_clock.micro_time();
+  if (now < m_busy_until) {
+    const chrono::MicroTime duration = m_busy_until - now;
+    m_busy_wait_time += duration;
+    chrono::wait(duration);
+  }
+}
+
+void SimulatedDisplayDevice::transfer(u32 size) {
+  const u32 frequency = m_construct.bus_frequency();
+  if (frequency == 0) {
+    return;
+  }
+
+  // the caller is blocked while the bytes are on the bus
+  const chrono::MicroTime duration(u32(u64(size) * 8 * 1000000 / frequency));
+  m_bus_time += duration;
+  chrono::wait(duration);
+}
@@ -1,5 +1,6 @@
 // Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
 
+#include "ux/Assets.hpp"
 #include "ux/TextArea.hpp"
 #include "ux/TouchGesture.hpp"
 #include "ux/draw/TextBox.hpp"
@@ -7,7 +8,9 @@
 using namespace ux::sgfx;
 using namespace ux;
 
-TextArea::TextArea(const var::StringView name) : ComponentAccess(name) {}
+TextArea::TextArea(const var::StringView name) : ComponentAccess(name) {
+  m_paragraph_list.push_back(create_paragraph(0));
+}
 
 void TextArea::draw(const DrawingScaledAttributes &attributes) {
   draw_base_properties(attributes.bitmap(), attributes.region(), theme());
@@ -20,6 +23,35 @@ void TextArea::draw(const DrawingScaledAttributes &attributes) {
   // calculate the font point size scaled from drawing size to sgfx size
   m_line_height = text_height() * region_inside_padding.height() * 9 / 10000;
 
+  if (is_buffer_mode()) {
+    const Assets::FontAsset *entry = Assets::find_font(
+      Assets::FindFont()
+        .set_name(
+          font_name().is_empty() ? theme()->primary_font_name() : font_name())
+        .set_point_size(m_line_height));
+    const Font *font = entry != nullptr ? &entry->font() : nullptr;
+
+    if (
+      (font != m_layout_font)
+      || (region_inside_padding.width() != m_text_region.width())) {
+      // every paragraph wraps differently
+      for (Paragraph &paragraph : m_paragraph_list) {
+        paragraph.is_wrapped = false;
+      }
+    }
+
+    m_layout_font = font;
+    m_text_region = region_inside_padding;
+    if (font != nullptr) {
+      wrap_paragraphs();
+      update_scroll();
+      draw_lines(attributes.bitmap(), 0, m_line_count);
+    }
+
+    apply_antialias_filter(attributes);
+    return;
+  }
+
   // if the label is available, draw it
 
   m_text_box.set_font(nullptr)
@@ -28,6 +60,7 @@ void TextArea::draw(const DrawingScaledAttributes &attributes) {
       font_name().is_empty() ? theme()->primary_font_name() : font_name())
     .set_font_point_size(m_line_height)
     .set_color(theme()->text_color())
+    .set_blend_theme(theme(), theme_style(), theme_state())
     .set_alignment(alignment())
     .draw(
       attributes + region_inside_padding.point()
@@ -46,18 +79,24 @@ void TextArea::handle_event(const ux::Event &event) {
         sg_size_t line_compare = m_line_height / 2;
         m_scroll_accumulator += touch_context->drag().y();
 
-        sg_size_t scroll = m_text_box.scroll();
+        const size_t scroll = this->scroll();
         while (m_scroll_accumulator > line_compare) {
           m_scroll_accumulator -= line_compare;
           m_text_box.decrement_scroll();
+          if (m_line_scroll) {
+            m_line_scroll--;
+          }
         }
 
         while (m_scroll_accumulator < -1 * line_compare) {
           m_scroll_accumulator += line_compare;
           m_text_box.increment_scroll();
+          if (m_line_scroll < m_line_scroll_total) {
+            m_line_scroll++;
+          }
         }
 
-        if (scroll != m_text_box.scroll()) {
+        if (scroll != this->scroll()) {
           redraw();
         }
       }
@@ -67,3 +106,265 @@ void TextArea::handle_event(const ux::Event &event) {
     }
   }
 }
+
+TextArea &TextArea::insert(size_t position, const var::StringView text) {
+  if (position > m_text_buffer.size()) {
+    position = m_text_buffer.size();
+  }
+
+  m_text_buffer.insert(position, text);
+
+  size_t offset;
+  const size_t first = find_paragraph(position, offset);
+  const size_t previous_line_count = count_lines(first, first + 1);
+  m_paragraph_list.at(first).is_wrapped = false;
+
+  size_t newline = text.find("\n");
+  if (newline == var::StringView::npos) {
+    m_paragraph_list.at(first).length += text.length();
+    update_edited_lines(first, first + 1, previous_line_count);
+    return *this;
+  }
+
+  // each newline in the text starts a new paragraph
+  const size_t tail = m_paragraph_list.at(first).length - offset;
+  m_paragraph_list.at(first).length = offset + newline;
+  size_t last = first;
+  size_t start = newline + 1;
+  while ((newline = text.find("\n", start)) != var::StringView::npos) {
+    last++;
+    m_paragraph_list.insert(
+      m_paragraph_list.begin() + last,
+      create_paragraph(newline - start));
+    start = newline + 1;
+  }
+
+  last++;
+  m_paragraph_list.insert(
+    m_paragraph_list.begin() + last,
+    create_paragraph(text.length() - start + tail));
+
+  update_edited_lines(first, last + 1, previous_line_count);
+  return *this;
+}
+
+TextArea &TextArea::remove(size_t position, size_t length) {
+  if (position >= m_text_buffer.size()) {
+    return *this;
+  }
+
+  if (length > m_text_buffer.size() - position) {
+    length = m_text_buffer.size() - position;
+  }
+
+  size_t first_offset;
+  size_t last_offset;
+  const size_t first = find_paragraph(position, first_offset);
+  const size_t last = find_paragraph(position + length, last_offset);
+  const size_t previous_line_count = count_lines(first, last + 1);
+
+  m_text_buffer.remove(position, length);
+
+  // the paragraphs the removed text spans become one
+  Paragraph &paragraph = m_paragraph_list.at(first);
+  paragraph.length
+    = first_offset + m_paragraph_list.at(last).length - last_offset;
+  paragraph.is_wrapped = false;
+  for (size_t i = first; i < last; i++) {
+    m_paragraph_list.remove(first + 1);
+  }
+
+  update_edited_lines(first, first + 1, previous_line_count);
+  return *this;
+}
+
+size_t
+TextArea::find_paragraph(size_t position, size_t &paragraph_offset) const {
+  size_t start = 0;
+  for (size_t i = 0; i < m_paragraph_list.count(); i++) {
+    const size_t length = m_paragraph_list.at(i).length;
+    if (position <= start + length) {
+      paragraph_offset = position - start;
+      return i;
+    }
+    // skip the newline
+    start += length + 1;
+  }
+
+  paragraph_offset = m_paragraph_list.back().length;
+  return m_paragraph_list.count() - 1;
+}
+
+var::StringView TextArea::read_text(size_t position, size_t length) {
+  if (m_scratch.size() < length) {
+    m_scratch.resize(length);
+  }
+  const size_t size
+    = m_text_buffer.read(position, var::View(m_scratch.data(), length));
+  return var::StringView(
+    reinterpret_cast<const char *>(m_scratch.data()),
+    size);
+}
+
+void TextArea::wrap_paragraphs() {
+  size_t position = 0;
+  m_line_count = 0;
+  for (Paragraph &paragraph : m_paragraph_list) {
+    if (paragraph.is_wrapped == false) {
+      draw::TextBox::build_line_list(
+        m_layout_font,
+        read_text(position, paragraph.length),
+        m_text_region.width(),
+        paragraph.line_list);
+      paragraph.is_wrapped = true;
+    }
+    m_line_count += paragraph.line_list.count();
+    position += paragraph.length + 1;
+  }
+}
+
+void TextArea::update_scroll() {
+  const sg_size_t font_height = m_layout_font->get_height();
+  const size_t visible_lines
+    = m_text_region.height() / (font_height + font_height / 10);
+
+  m_line_scroll_total
+    = m_line_count > visible_lines ? m_line_count - visible_lines : 0;
+  if (m_line_scroll > m_line_scroll_total) {
+    m_line_scroll = m_line_scroll_total;
+  }
+}
+
+size_t TextArea::count_lines(size_t first, size_t last) const {
+  size_t result = 0;
+  for (size_t i = first; i < last; i++) {
+    result += m_paragraph_list.at(i).line_list.count();
+  }
+  return result;
+}
+
+sgfx::Region TextArea::draw_lines(Bitmap &bitmap, size_t first, size_t last) {
+  const sg_size_t font_height = m_layout_font->get_height();
+  const sg_size_t row_height = font_height + font_height / 10;
+  const size_t visible_lines = m_text_region.height() / row_height;
+  const size_t start = first > m_line_scroll ? first : m_line_scroll;
+  const size_t end = last < m_line_scroll + visible_lines
+                       ? last
+                       : m_line_scroll + visible_lines;
+  if (start >= end) {
+    return Region();
+  }
+
+  const Region result(
+    Point(
+      m_text_region.x(),
+      m_text_region.y() + (start - m_line_scroll) * row_height),
+    Area(m_text_region.width(), (end - start) * row_height));
+
+  bitmap.set_pen(Pen().set_color(theme()->color())).draw_rectangle(result);
+  bitmap.set_pen(Pen().set_color(theme()->text_color()).set_zero_transparent());
+
+  const BlendTable *blend_table = nullptr;
+  if (m_layout_font->is_antialiased()) {
+    blend_table = theme()->get_blend_table(
+      theme_style(),
+      theme_state(),
+      static_cast<BlendTable::BitsPerPixel>(m_layout_font->bits_per_pixel()));
+    if (blend_table->is_valid() == false) {
+      blend_table = nullptr;
+    }
+  }
+
+  size_t position = 0;
+  size_t line_index = 0;
+  for (const Paragraph &paragraph : m_paragraph_list) {
+    if (line_index >= end) {
+      break;
+    }
+
+    if (line_index + paragraph.line_list.count() > start) {
+      for (const draw::TextBox::Line &line : paragraph.line_list) {
+        if ((line_index >= start) && (line_index < end)) {
+          sg_int_t x;
+          if (is_align_left()) {
+            x = m_text_region.x();
+          } else if (is_align_right()) {
+            x = m_text_region.x() + m_text_region.width() - line.width;
+          } else {
+            x = m_text_region.x() + (m_text_region.width() - line.width) / 2;
+          }
+
+          const Point point(
+            x,
+            m_text_region.y() + (line_index - m_line_scroll) * row_height);
+          const var::StringView text
+            = read_text(position + line.offset, line.length);
+          if (blend_table) {
+            m_layout_font->draw(text, bitmap, point, *blend_table);
+          } else {
+            m_layout_font->draw(text, bitmap, point);
+          }
+        }
+        line_index++;
+      }
+    } else {
+      line_index += paragraph.line_list.count();
+    }
+
+    position += paragraph.length + 1;
+  }
+
+  return result;
+}
+
+void TextArea::update_edited_lines(
+  size_t first,
+  size_t last,
+  size_t previous_line_count) {
+  if (
+    !is_buffer_mode() || (m_layout_font == nullptr)
+    || (is_ready_to_draw() == false)) {
+    // the paragraphs are wrapped when the text area is drawn
+    return;
+  }
+
+  size_t position = 0;
+  size_t first_line = 0;
+  for (size_t i = 0; i < first; i++) {
+    position += m_paragraph_list.at(i).length + 1;
+    first_line += m_paragraph_list.at(i).line_list.count();
+  }
+
+  // only the edited paragraphs are wrapped again
+  for (size_t i = first; i < last; i++) {
+    Paragraph &paragraph = m_paragraph_list.at(i);
+    draw::TextBox::build_line_list(
+      m_layout_font,
+      read_text(position, paragraph.length),
+      m_text_region.width(),
+      paragraph.line_list);
+    paragraph.is_wrapped = true;
+    position += paragraph.length + 1;
+  }
+
+  const size_t line_count = count_lines(first, last);
+  m_line_count = m_line_count + line_count - previous_line_count;
+
+  const size_t scroll = m_line_scroll;
+  update_scroll();
+
+  Region region;
+  Bitmap &bitmap = local_drawing_attributes().bitmap();
+  if (scroll != m_line_scroll) {
+    // every row moved; rows past the end are cleared
+    region = draw_lines(bitmap, 0, static_cast<size_t>(-1));
+  } else if (line_count == previous_line_count) {
+    // the lines below the edit did not move
+    region = draw_lines(bitmap, first_line, first_line + line_count);
+  } else {
+    // lines below the edit moved; rows past the end are cleared
+    region = draw_lines(bitmap, first_line, static_cast<size_t>(-1));
+  }
+
+  set_refresh_drawing_pending(region);
+}
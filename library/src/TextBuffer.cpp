@@ -0,0 +1,142 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include <cstring>
+
+#include "ux/TextBuffer.hpp"
+
+using namespace ux;
+
+TextBuffer::TextBuffer(const var::StringView original)
+  : m_original(original) {
+  if (original.length()) {
+    m_piece_list.push_back({Source::original, 0, u32(original.length())});
+    m_size = original.length();
+  }
+}
+
+TextBuffer &TextBuffer::insert(size_t position, const var::StringView text) {
+  if (text.length() == 0) {
+    return *this;
+  }
+
+  if (position > m_size) {
+    position = m_size;
+  }
+
+  const u32 offset = m_append.length();
+  m_append.append(text);
+  m_size += text.length();
+
+  size_t piece_offset;
+  const size_t index = find_piece(position, piece_offset);
+  if ((piece_offset == 0) && (index > 0)) {
+    // typing and appending extend the piece that was just inserted
+    Piece &previous = m_piece_list.at(index - 1);
+    if (
+      (previous.source == Source::append)
+      && (previous.offset + previous.length == offset)) {
+      previous.length += text.length();
+      return *this;
+    }
+  }
+
+  const size_t split = split_piece(position);
+  m_piece_list.insert(
+    m_piece_list.begin() + split,
+    {Source::append, offset, u32(text.length())});
+  return *this;
+}
+
+TextBuffer &TextBuffer::remove(size_t position, size_t length) {
+  if (position >= m_size) {
+    return *this;
+  }
+
+  if (length > m_size - position) {
+    length = m_size - position;
+  }
+
+  const size_t first = split_piece(position);
+  const size_t last = split_piece(position + length);
+  for (size_t i = first; i < last; i++) {
+    m_piece_list.remove(first);
+  }
+  m_size -= length;
+  return *this;
+}
+
+TextBuffer &TextBuffer::clear() {
+  m_piece_list = var::Vector<Piece>();
+  m_append = var::String();
+  m_original = var::StringView();
+  m_size = 0;
+  return *this;
+}
+
+size_t TextBuffer::read(size_t position, var::View destination) const {
+  size_t piece_offset;
+  size_t index = find_piece(position, piece_offset);
+  char *target = destination.to_char();
+  size_t result = 0;
+
+  while ((index < m_piece_list.count()) && (result < destination.size())) {
+    const Piece &piece = m_piece_list.at(index);
+    size_t size = piece.length - piece_offset;
+    if (size > destination.size() - result) {
+      size = destination.size() - result;
+    }
+    memcpy(target + result, piece_data(piece) + piece_offset, size);
+    result += size;
+    piece_offset = 0;
+    index++;
+  }
+  return result;
+}
+
+char TextBuffer::at(size_t position) const {
+  size_t piece_offset;
+  const size_t index = find_piece(position, piece_offset);
+  if (index >= m_piece_list.count()) {
+    return 0;
+  }
+  return piece_data(m_piece_list.at(index))[piece_offset];
+}
+
+var::String TextBuffer::to_string() const {
+  var::String result;
+  for (const Piece &piece : m_piece_list) {
+    result.append(var::StringView(piece_data(piece), piece.length));
+  }
+  return result;
+}
+
+size_t TextBuffer::find_piece(size_t position, size_t &piece_offset) const {
+  size_t start = 0;
+  for (size_t i = 0; i < m_piece_list.count(); i++) {
+    const size_t length = m_piece_list.at(i).length;
+    if (position < start + length) {
+      piece_offset = position - start;
+      return i;
+    }
+    start += length;
+  }
+  piece_offset = 0;
+  return m_piece_list.count();
+}
+
+size_t TextBuffer::split_piece(size_t position) {
+  size_t piece_offset;
+  const size_t index = find_piece(position, piece_offset);
+  if (piece_offset == 0) {
+    return index;
+  }
+
+  Piece &piece = m_piece_list.at(index);
+  const Piece tail
+    = {piece.source,
+       u32(piece.offset + piece_offset),
+       u32(piece.length - piece_offset)};
+  piece.length = piece_offset;
+  m_piece_list.insert(m_piece_list.begin() + index + 1, tail);
+  return index + 1;
+}
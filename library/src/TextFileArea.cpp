@@ -3,6 +3,7 @@
 #include <fs.hpp>
 #include <var.hpp>
 
+#include "ux/Assets.hpp"
 #include "ux/TextFileArea.hpp"
 #include "ux/TouchGesture.hpp"
 #include "ux/draw/TextBox.hpp"
@@ -11,15 +12,21 @@ using namespace ux::sgfx;
 using namespace ux;
 
 TextFileArea::TextFileArea(const var::StringView name, const Construct &options)
-  : ComponentAccess(name), m_source(options.source()) {
+  : ComponentAccess(name), m_source(options.source()),
+    m_encoding(options.encoding()) {
 
   if (m_source != nullptr) {
     m_page_buffer = options.page_buffer();
+    m_is_content_size_fixed = options.content_size() != 0;
     m_content_location = m_source->location();
     m_content_size = options.content_size() ? options.content_size()
                                             : m_source->size_signed();
     m_page_start = m_content_location;
-    load_page_buffer();
+    if (is_fixed_width()) {
+      m_page_reader.set_buffer(m_page_buffer);
+    } else {
+      load_page_buffer();
+    }
   } else {
     m_display_text = StringView(m_page_buffer.to_char(), m_page_buffer.size());
   }
@@ -41,12 +48,19 @@ void TextFileArea::draw(const DrawingScaledAttributes &attributes) {
   const auto draw_attributes
     = attributes + region_inside_padding.point() + region_inside_padding.area();
 
+  if (is_fixed_width() && m_source != nullptr) {
+    draw_fixed_width(draw_attributes);
+    apply_antialias_filter(attributes);
+    return;
+  }
+
   m_text_box.set_font(nullptr)
     .set_string(m_display_text)
     .set_font_name(
       font_name().is_empty() ? theme()->primary_font_name() : font_name())
     .set_font_point_size(m_line_height)
     .set_color(theme()->text_color())
+    .set_blend_theme(theme(), theme_style(), theme_state())
     .set_alignment(alignment())
     .draw(draw_attributes);
 
@@ -56,6 +70,45 @@ void TextFileArea::draw(const DrawingScaledAttributes &attributes) {
 }
 
 void TextFileArea::handle_event(const ux::Event &event) {
+  if (SystemEvent::is_periodic(event)) {
+    if (is_fixed_width()) {
+      if (m_source != nullptr && m_visible_line_count) {
+        // read the next page while the application is idle
+        const size_t line_size = bytes_per_line();
+        const size_t window_size = m_visible_line_count * line_size;
+        const size_t page_location = m_page_reader.location();
+        size_t location;
+        if (m_is_scroll_forward) {
+          location = page_location + m_page_reader.page_size() - window_size;
+        } else {
+          location = page_location + window_size > m_page_reader.page_size()
+                       ? page_location + window_size
+                           - m_page_reader.page_size()
+                       : 0;
+        }
+
+        if (location < m_content_location) {
+          location = m_content_location;
+        }
+        location -= (location - m_content_location) % line_size;
+        update_content_size();
+        m_page_reader.prefetch(
+          *m_source,
+          location,
+          m_content_location + m_content_size);
+      }
+      return;
+    }
+
+    // build the line index while the application is idle
+    for (size_t i = 0; i < index_chunk_count; i++) {
+      if (update_line_index() == false) {
+        break;
+      }
+    }
+    return;
+  }
+
   const TouchContext *touch_context = event.is_trigger<TouchContext>();
   if (touch_context) {
     if (event.id() == TouchContext::event_id_dragged_point) {
@@ -114,22 +167,248 @@ void TextFileArea::load_page_buffer() {
     m_is_text_box_scroll_mode = false;
   }
 
-  m_scroll = ((m_page_start - m_content_location) * 25 + m_content_size / 2)
-             / m_content_size;
-
+  // the page is read into the same buffer
   m_display_text = StringView(m_page_buffer.to_char(), bytes_read);
+  m_text_box.refresh_string();
+}
+
+void TextFileArea::draw_fixed_width(
+  const DrawingScaledAttributes &attributes) {
+  const Assets::FontAsset *entry = Assets::find_font(
+    Assets::FindFont()
+      .set_name(
+        font_name().is_empty() ? theme()->primary_font_name() : font_name())
+      .set_point_size(m_line_height)
+      .set_style(Font::Style::regular));
+
+  m_display_width = attributes.area().width();
+
+  if (entry == nullptr || entry->font().get_height() == 0) {
+    return;
+  }
+
+  const Font &font = entry->font();
+  const sg_size_t height = font.get_height();
+  const size_t line_size = bytes_per_line();
+
+  // the visible lines must fit in one page
+  m_visible_line_count = attributes.area().height() / height;
+  if (m_visible_line_count > m_page_reader.page_size() / line_size) {
+    m_visible_line_count = m_page_reader.page_size() / line_size;
+  }
+
+  update_content_size();
+  const size_t location = m_line * line_size;
+  const var::View page = m_page_reader.get(
+    *m_source,
+    m_content_location + location,
+    m_visible_line_count * line_size,
+    m_content_location + m_content_size);
+
+  attributes.bitmap().set_pen(
+    Pen().set_color(theme()->text_color()).set_zero_transparent());
+
+  const BlendTable *blend_table = nullptr;
+  if (font.is_antialiased()) {
+    blend_table = theme()->get_blend_table(
+      theme_style(),
+      theme_state(),
+      static_cast<BlendTable::BitsPerPixel>(font.bits_per_pixel()));
+    if (blend_table->is_valid() == false) {
+      blend_table = nullptr;
+    }
+  }
+
+  // the longest line is a hexadecimal line with 16 bytes
+  char line[80];
+  sg_int_t y = attributes.point().y();
+  for (size_t offset = 0; offset < page.size(); offset += line_size) {
+    const size_t size
+      = page.size() - offset < line_size ? page.size() - offset : line_size;
+    const size_t length = format_line(
+      var::View(page.to_const_u8() + offset, size),
+      location + offset,
+      line);
+    const StringView text(line, length);
+    const Point point(attributes.point().x(), y);
+    if (blend_table) {
+      font.draw(text, attributes.bitmap(), point, *blend_table);
+    } else {
+      font.draw(text, attributes.bitmap(), point);
+    }
+    y += height;
+  }
+}
+
+size_t TextFileArea::format_line(
+  const var::View data,
+  size_t location,
+  char *line) const {
+  static const char hex_digits[] = "0123456789ABCDEF";
+  const size_t line_size = bytes_per_line();
+  const u8 *bytes = data.to_const_u8();
+  size_t length = 0;
+
+  for (int shift = 28; shift >= 0; shift -= 4) {
+    line[length++] = hex_digits[(location >> shift) & 0x0f];
+  }
+  line[length++] = ' ';
+
+  for (size_t i = 0; i < line_size; i++) {
+    line[length++] = ' ';
+    if (m_encoding == Encoding::hexadecimal) {
+      // missing bytes are padded so the characters line up
+      line[length++] = i < data.size() ? hex_digits[bytes[i] >> 4] : ' ';
+      line[length++] = i < data.size() ? hex_digits[bytes[i] & 0x0f] : ' ';
+    } else {
+      for (int bit = 7; bit >= 0; bit--) {
+        line[length++]
+          = i < data.size() ? ((bytes[i] >> bit) & 0x01 ? '1' : '0') : ' ';
+      }
+    }
+  }
+
+  line[length++] = ' ';
+  line[length++] = ' ';
+  for (size_t i = 0; i < data.size(); i++) {
+    line[length++] = (bytes[i] >= ' ' && bytes[i] < 0x7f) ? bytes[i] : '.';
+  }
+  return length;
+}
+
+void TextFileArea::update_content_size() {
+  if (m_is_content_size_fixed == false) {
+    // keep up with files that are growing
+    m_content_size = m_source->size() - m_content_location;
+  }
+}
+
+void TextFileArea::PageReader::set_buffer(var::View buffer) {
+  const size_t size = buffer.size() / 2;
+  m_page[0].buffer = var::View(buffer.to_u8(), size);
+  m_page[1].buffer = var::View(buffer.to_u8() + size, size);
+  invalidate();
+}
+
+var::View TextFileArea::PageReader::get(
+  const fs::FileObject &source,
+  size_t location,
+  size_t size,
+  size_t end) {
+  if (location + size > end) {
+    size = end > location ? end - location : 0;
+  }
+
+  if (size > page_size()) {
+    size = page_size();
+  }
+
+  for (u8 i = 0; i < 2; i++) {
+    if (m_page[i].size && m_page[i].contains(location, size)) {
+      m_current = i;
+      return var::View(
+        m_page[i].buffer.to_const_u8() + location - m_page[i].location,
+        size);
+    }
+  }
+
+  // replace the page that is not being drawn
+  m_current ^= 1;
+  Page &page = m_page[m_current];
+  const size_t bytes_read = read(source, page, location, end);
+  return var::View(
+    page.buffer.to_const_u8(),
+    size < bytes_read ? size : bytes_read);
+}
+
+void TextFileArea::PageReader::prefetch(
+  const fs::FileObject &source,
+  size_t location,
+  size_t end) {
+  for (const Page &page : m_page) {
+    if (page.size && page.location == location) {
+      return;
+    }
+  }
+
+  if (location < end) {
+    read(source, m_page[m_current ^ 1], location, end);
+  }
+}
+
+size_t TextFileArea::PageReader::read(
+  const fs::FileObject &source,
+  Page &page,
+  size_t location,
+  size_t end) {
+  const size_t remaining = end > location ? end - location : 0;
+  const size_t size
+    = remaining < page.buffer.size() ? remaining : page.buffer.size();
+
+  page.location = location;
+  page.size = 0;
+  if (size == 0) {
+    return 0;
+  }
+
+  const int result = source.seek(location)
+                       .read(var::View(page.buffer.to_u8(), size))
+                       .return_value();
+  page.size = result > 0 ? result : 0;
+  return page.size;
+}
+
+TextFileArea &TextFileArea::scroll_to(size_t line) {
+  if (m_source == nullptr) {
+    m_text_box.set_scroll(line);
+    return *this;
+  }
+
+  if (is_fixed_width()) {
+    const size_t total = scroll_total();
+    m_is_scroll_forward = line >= m_line;
+    m_line = (total && line >= total) ? total - 1 : line;
+    return *this;
+  }
+
+  m_text_box.set_scroll(0);
+  load_line(line);
+  return *this;
+}
+
+size_t TextFileArea::scroll_total() const {
+  if (m_source == nullptr) {
+    return m_text_box.scroll_total();
+  }
+
+  if (is_fixed_width()) {
+    return (m_content_size + bytes_per_line() - 1) / bytes_per_line();
+  }
+
+  if (is_line_index_complete() || (m_index_location == 0)) {
+    return m_index_line_count;
+  }
+
+  // estimate using the lines per byte that have been indexed so far
+  return u64(m_index_line_count) * m_content_size / m_index_location;
 }
 
 void TextFileArea::handle_increment_scroll() {
+  if (is_fixed_width() && m_source != nullptr) {
+    m_is_scroll_forward = true;
+    if ((m_line + 1) * bytes_per_line() < m_content_size) {
+      m_line++;
+    }
+    return;
+  }
+
   // scroll to a place further a long in the file
   if (m_is_text_box_scroll_mode || m_source == nullptr) {
     m_text_box.increment_scroll();
-    if (m_text_box.scroll() > m_text_box.scroll_total()) {
-      m_scroll = m_scroll_total;
-    }
     return;
   }
 
+  m_line++;
   m_page_start
     = m_source->seek(m_page_start + m_text_box.first_line_length() + 1)
         .location();
@@ -137,6 +416,14 @@ void TextFileArea::handle_increment_scroll() {
 }
 
 void TextFileArea::handle_decrement_scroll() {
+  if (is_fixed_width() && m_source != nullptr) {
+    m_is_scroll_forward = false;
+    if (m_line > 0) {
+      m_line--;
+    }
+    return;
+  }
+
   if (m_is_text_box_scroll_mode || m_source == nullptr) {
     if (m_text_box.scroll() > 1) {
       m_text_box.decrement_scroll();
@@ -145,41 +432,252 @@ void TextFileArea::handle_decrement_scroll() {
     }
     if (m_source) {
       m_is_text_box_scroll_mode = false;
+      m_text_box.set_scroll(0);
     } else {
       return;
     }
   }
 
-  GeneralString line_buffer;
-  const bool is_full_capacity
-    = (m_page_start - m_content_location) > line_buffer.capacity();
+  if (m_line == 0) {
+    return;
+  }
+
+  if (m_is_line_estimated) {
+    // the line number is not known yet so step back from the page
+    m_line--;
+    m_page_start
+      = m_source
+          ->seek(
+            m_content_location
+            + find_previous_line_location(m_page_start - m_content_location))
+          .location();
+    load_page_buffer();
+    return;
+  }
+
+  load_line(m_line - 1);
+}
+
+void TextFileArea::load_line(size_t line) {
+  const size_t location = find_line_location(line);
+  m_line = line;
+  m_page_start = m_source->seek(m_content_location + location).location();
+  load_page_buffer();
+}
+
+bool TextFileArea::update_line_index() {
+  const Font *font = m_text_box.font();
+  if ((m_source == nullptr) || (font == nullptr) || (m_display_width == 0)) {
+    return false;
+  }
+
+  if ((font != m_index_font) || (m_display_width != m_index_width)) {
+    // lines are wrapped differently
+    m_checkpoint_list = var::Vector<u32>();
+    m_index_font = font;
+    m_index_width = m_display_width;
+    m_index_location = 0;
+    m_index_line_count = 0;
+    m_is_index_tail = false;
+  }
+
+  update_content_size();
+
+  if (m_is_index_tail && (m_index_location < m_content_size)) {
+    // the last paragraph continues, so it is wrapped again
+    m_index_location = m_index_tail_location;
+    m_index_line_count = m_index_tail_line_count;
+    while (m_checkpoint_list.count()
+           > (m_index_line_count + checkpoint_interval - 1)
+               / checkpoint_interval) {
+      m_checkpoint_list.pop_back();
+    }
+    m_is_index_tail = false;
+  }
+
+  if (m_index_location >= m_content_size) {
+    return false;
+  }
+
+  // the end of a growing file is indexed once the size stops changing
+  const bool is_tail = (m_is_content_size_fixed == false)
+                       && (m_content_size == m_index_wait_size);
+
+  GeneralString buffer;
+  var::Vector<draw::TextBox::Line> line_list;
+  const size_t consumed
+    = read_lines(m_index_location, buffer, line_list, is_tail);
+  if (consumed == 0) {
+    // wait for the rest of the last paragraph
+    m_index_wait_size = m_content_size;
+    return false;
+  }
+
+  if (is_tail && (m_index_location + consumed >= m_content_size)) {
+    m_is_index_tail = true;
+    m_index_tail_location = m_index_location;
+    m_index_tail_line_count = m_index_line_count;
+  }
+
+  const size_t page_location = m_page_start - m_content_location;
+  size_t page_line = m_line;
+  for (const draw::TextBox::Line &line : line_list) {
+    const size_t location = m_index_location + line.offset;
+    if (m_index_line_count % checkpoint_interval == 0) {
+      m_checkpoint_list.push_back(location);
+    }
+    if (location <= page_location) {
+      page_line = m_index_line_count;
+    }
+    m_index_line_count++;
+  }
+  m_index_location += consumed;
+
+  if (m_is_line_estimated && (m_index_location > page_location)) {
+    // the index has reached the page so the line number is known
+    m_line = page_line;
+    m_is_line_estimated = false;
+  }
+  return true;
+}
+
+size_t TextFileArea::find_line_location(size_t line) {
+  if (m_index_line_count == 0) {
+    // one chunk gives the lines per byte used for estimates
+    update_line_index();
+  }
+
+  if (m_checkpoint_list.count() == 0) {
+    return m_page_start - m_content_location;
+  }
+
+  if ((line >= m_index_line_count) && !is_line_index_complete()) {
+    return estimate_line_location(line);
+  }
+
+  m_is_line_estimated = false;
+
+  if (line >= m_index_line_count) {
+    line = m_index_line_count - 1;
+  }
+
+  // seek to the checkpoint then wrap the lines after it
+  const size_t checkpoint = line / checkpoint_interval;
+  size_t location = m_checkpoint_list.at(checkpoint);
+  size_t skip_count = line - checkpoint * checkpoint_interval;
+
+  GeneralString buffer;
+  var::Vector<draw::TextBox::Line> line_list;
+  while (skip_count > 0) {
+    const size_t consumed
+      = read_lines(location, buffer, line_list, m_is_index_tail);
+    if (consumed == 0) {
+      break;
+    }
+    if (skip_count < line_list.count()) {
+      return location + line_list.at(skip_count).offset;
+    }
+    skip_count -= line_list.count();
+    location += consumed;
+  }
+  return location;
+}
+
+size_t TextFileArea::estimate_line_location(size_t line) {
+  // jump ahead of the index rather than reading every line before
+  // the one that is shown; update_line_index() corrects m_line
+  size_t location = u64(line) * m_index_location / m_index_line_count;
+  if (location >= m_content_size) {
+    location = m_content_size - 1;
+  }
 
-  const auto preload_start = is_full_capacity
-                               ? m_page_start - line_buffer.capacity()
-                               : m_content_location;
-  const auto preload_size
-    = is_full_capacity ? line_buffer.capacity() : m_page_start;
+  // start at a paragraph so the lines wrap as they do in the index
+  GeneralString buffer;
+  const size_t start = location - 1;
+  const size_t remaining = m_content_size - start;
+  const size_t size
+    = remaining < buffer.capacity() ? remaining : buffer.capacity();
+  m_source->seek(m_content_location + start)
+    .read(var::View(buffer.data(), size));
+  const size_t offset = StringView(buffer.data(), size).find("\n");
+  if ((offset != StringView::npos) && (start + offset + 1 < m_content_size)) {
+    location = start + offset + 1;
+  }
 
+  m_is_line_estimated = true;
+  return location;
+}
 
-  m_source->seek(preload_start)
-    .read(var::View(line_buffer.data(), preload_size));
-  line_buffer.data()[preload_size] = 0;
+size_t TextFileArea::find_previous_line_location(size_t location) const {
+  if (location == 0) {
+    return 0;
+  }
 
-  API_ASSERT(m_text_box.font() != nullptr);
-  // use text box to build out the lines
-  const auto count_lines_result = draw::TextBox::count_lines(
+  GeneralString buffer;
+  const size_t size
+    = location < buffer.capacity() ? location : buffer.capacity();
+  const size_t start = location - size;
+  m_source->seek(m_content_location + start)
+    .read(var::View(buffer.data(), size));
+
+  // wrap the paragraph that holds the byte before location
+  StringView chunk(buffer.data(), size);
+  if (chunk.at(size - 1) == '\n') {
+    chunk = chunk.get_substring_with_length(size - 1);
+  }
+  const size_t end = chunk.reverse_find("\n");
+  const size_t paragraph = end == StringView::npos ? 0 : end + 1;
+
+  var::Vector<draw::TextBox::Line> line_list;
+  draw::TextBox::build_line_list(
     m_text_box.font(),
-    line_buffer,
-    m_display_width);
+    chunk.get_substring_at_position(paragraph),
+    m_display_width,
+    line_list);
+  return start + paragraph
+         + (line_list.count() ? line_list.back().offset : 0);
+}
 
-  m_page_start
-    = m_page_start - m_content_location
-          < count_lines_result.characters_on_last_line + 1
-        ? m_content_location
-        : m_page_start - count_lines_result.characters_on_last_line - 1;
+size_t TextFileArea::read_lines(
+  size_t location,
+  var::GeneralString &buffer,
+  var::Vector<draw::TextBox::Line> &line_list,
+  bool is_tail) const {
+  line_list.clear();
+  const size_t remaining = m_content_size - location;
+  const size_t size
+    = remaining < buffer.capacity() ? remaining : buffer.capacity();
+  if (size == 0) {
+    return 0;
+  }
 
+  m_source->seek(m_content_location + location)
+    .read(var::View(buffer.data(), size));
+  StringView chunk(buffer.data(), size);
+
+  size_t consumed = size;
+  if (
+    (size < remaining)
+    || ((m_is_content_size_fixed == false) && (is_tail == false))) {
+    // wrap complete paragraphs so lines continue in the next chunk
+    size_t end = chunk.reverse_find("\n");
+    if ((end == StringView::npos) && (size == buffer.capacity())) {
+      end = chunk.reverse_find(" ");
+    }
 
-  m_source->seek(m_page_start);
+    if (end != StringView::npos) {
+      consumed = end + 1;
+      chunk = chunk.get_substring_with_length(end);
+    } else if (size < buffer.capacity()) {
+      // wait for the rest of the paragraph
+      return 0;
+    }
+  }
 
-  load_page_buffer();
+  draw::TextBox::build_line_list(
+    m_text_box.font(),
+    chunk,
+    m_display_width,
+    line_list);
+  return consumed;
 }
@@ -0,0 +1,133 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include <var.hpp>
+
+#include "ux/VirtualList.hpp"
+
+using namespace ux;
+
+VirtualList &VirtualList::reload() {
+  for (size_t &index : m_index_list) {
+    index = npos;
+  }
+
+  const u32 maximum_scroll = calculate_maximum_scroll();
+  if (m_scroll > maximum_scroll) {
+    m_scroll = maximum_scroll;
+  }
+
+  scroll(DrawingPoint(0, 0));
+  return *this;
+}
+
+VirtualList &VirtualList::scroll_to(size_t index) {
+  const u32 maximum_scroll = calculate_maximum_scroll();
+  const u32 position = u32(index) * item_height();
+  m_scroll = position < maximum_scroll ? position : maximum_scroll;
+  scroll(DrawingPoint(0, 0));
+  return *this;
+}
+
+size_t VirtualList::get_index(const Component *component) const {
+  for (size_t i = 0; i < component_list().count(); i++) {
+    if (component_list().at(i).component() == component) {
+      return i < m_index_list.count() ? m_index_list.at(i) : npos;
+    }
+  }
+  return npos;
+}
+
+u32 VirtualList::calculate_maximum_scroll() const {
+  const u32 height = u32(count()) * item_height();
+  return height > Drawing::scale() ? height - Drawing::scale() : 0;
+}
+
+void VirtualList::update_row_count() {
+  // rows to cover the list when it is scrolled part way into a row
+  const size_t row_count
+    = (Drawing::scale() + item_height() - 1) / item_height() + 1
+      + 2 * overscan();
+
+  while (component_list().count() < row_count) {
+    ListItem &item = ListItem::create(var::IdString(name()).append(
+      var::NumberString(int(component_list().count()), "Row%d")));
+    Layout::add_component(item);
+    m_index_list.push_back(npos);
+  }
+}
+
+void VirtualList::generate_layout_positions() {
+  if (item_height() == 0) {
+    return;
+  }
+
+  update_row_count();
+
+  // the virtual list keeps its own scroll position; the layout
+  // origin only covers the rows
+  m_origin = DrawingPoint(0, 0);
+  m_area = DrawingArea(Drawing::scale(), Drawing::scale());
+
+  const size_t entry_count = count();
+  const size_t row_count = component_list().count();
+  const size_t first_visible = m_scroll / item_height();
+  const size_t first
+    = first_visible > overscan() ? first_visible - overscan() : 0;
+
+  // entry i is always shown by row i % row_count so scrolling by one
+  // entry only rebinds one row
+  for (size_t index = first; index < first + row_count; index++) {
+    const size_t row = index % row_count;
+    Item &item = component_list().at(row);
+    ListItem *list_item = item.component()->reinterpret<ListItem>();
+
+    // overlap the rows a little (see List::add_component())
+    const s32 y = s32(index * item_height()) - s32(m_scroll);
+    item.set_drawing_point(DrawingPoint(0, drawing_int_t(y)));
+    item.set_drawing_area(
+      DrawingArea(Drawing::scale(), item_height() + item_height() / 25));
+
+    if (index >= entry_count) {
+      m_index_list.at(row) = npos;
+      list_item->set_enabled(false);
+      continue;
+    }
+
+    if (m_index_list.at(row) != index) {
+      m_index_list.at(row) = index;
+      if (m_bind) {
+        m_bind(index, *list_item);
+      }
+
+      if (list_item->is_enabled() == false) {
+        list_item->set_enabled();
+      } else if (list_item->is_visible()) {
+        list_item->redraw();
+      }
+    }
+  }
+}
+
+drawing_int_t VirtualList::handle_vertical_scroll(sg_int_t scroll) {
+  const sg_size_t height
+    = reference_drawing_attributes().calculate_height_on_bitmap();
+  if (height == 0) {
+    return 0;
+  }
+
+  // dragging down moves toward the first entry
+  const s32 drawing_scroll = scroll * Drawing::scale() / height;
+  s32 position = s32(m_scroll) - drawing_scroll;
+  if (position < 0) {
+    position = 0;
+  }
+
+  const u32 maximum_scroll = calculate_maximum_scroll();
+  if (u32(position) > maximum_scroll) {
+    position = maximum_scroll;
+  }
+
+  const s32 result = s32(m_scroll) - position;
+  m_scroll = position;
+  return drawing_int_t(result);
+}
@@ -40,7 +40,13 @@ void Icon::draw(const DrawingScaledAttributes &attr) {
 
   f = this->icon_font();
 
-  size_t icon_index = f->find(name());
+  if ((m_index_font != f) || (m_index_revision != f->revision())) {
+    m_icon_index = f->find(name());
+    m_index_font = f;
+    m_index_revision = f->revision();
+  }
+
+  const size_t icon_index = m_icon_index;
   IconFont::IconInfo icon_info = f->get_info(icon_index);
 
   h = icon_info.height();
@@ -35,6 +35,19 @@ bool RichText::resolve_fonts(sg_size_t h) {
   return true;
 }
 
+var::Vector<RichText::RunList> RichText::m_run_cache;
+size_t RichText::m_run_cache_capacity = 16;
+u32 RichText::m_run_cache_access_count = 0;
+u32 RichText::m_run_cache_hit_count = 0;
+u32 RichText::m_run_cache_miss_count = 0;
+
+void RichText::set_run_cache_capacity(size_t value) {
+  m_run_cache_capacity = value;
+  if (m_run_cache.count() > value) {
+    clear_run_cache();
+  }
+}
+
 void RichText::draw(const DrawingScaledAttributes &attr) {
   Area d = attr.area();
 
@@ -42,52 +55,10 @@ void RichText::draw(const DrawingScaledAttributes &attr) {
     return;
   }
 
-  // search input for an icon :<icon>:
-  // parse the text() -- divide into tokens or either text or icons
-  auto raw_token_list = value().split(" ");
-  var::Vector<RichToken> rich_token_list;
-
-  rich_token_list.reserve(raw_token_list.count());
-
-  for (const auto raw_token : raw_token_list) {
-    RichToken entry;
-    if (
-      (raw_token.length() > 2) && (raw_token.front() == ':')
-      && (raw_token.back() == ':')) {
-      entry.set_type(RichToken::Type::icon)
-        .set_value(
-          raw_token(StringView::GetSubstring().set_position(1).set_length(
-            raw_token.length() - 2)));
-    } else {
-      entry.set_value(raw_token);
-    }
-    rich_token_list.push_back(entry);
-  }
-
-  // calculate the total width
-  sg_size_t max_height = text_font()->get_height();
-  sg_size_t total_width = 0;
-
-  for (RichToken &rich_token : rich_token_list) {
-    sg_size_t width;
-    sg_size_t height;
-    if (rich_token.type() == RichToken::Type::text) {
-      width = text_font()->get_width(rich_token.value());
-      height = text_font()->get_height();
-    } else {
-      width = 0;
-      rich_token.set_icon_index(icon_font()->find(rich_token.value()));
-      IconFont::IconInfo info = icon_font()->get_info(rich_token.icon_index());
-      height = info.height();
-      width = info.width();
-      if (info.height() > max_height) {
-        max_height = info.height();
-      }
-    }
-    rich_token.set_height(height);
-    rich_token.set_width(width);
-    total_width += width;
-  }
+  RunList scratch;
+  const RunList &run_list = get_run_list(scratch);
+  const sg_size_t max_height = run_list.max_height();
+  const sg_size_t total_width = run_list.total_width();
 
   sg_point_t p = attr.point();
   Point top_left;
@@ -113,22 +84,154 @@ void RichText::draw(const DrawingScaledAttributes &attr) {
 
   attr.bitmap().set_pen(Pen().set_color(m_color).set_zero_transparent());
 
-  for (const RichToken &rich_token : rich_token_list) {
+  const BlendTable *blend_table = nullptr;
+  if (m_blend_theme && text_font()->is_antialiased()) {
+    blend_table = m_blend_theme->get_blend_table(
+      m_blend_style,
+      m_blend_state,
+      static_cast<BlendTable::BitsPerPixel>(text_font()->bits_per_pixel()));
+    if (blend_table->is_valid() == false) {
+      blend_table = nullptr;
+    }
+  }
+
+  for (const Run &run : run_list.list()) {
     sg_size_t y_offset; // center within max height
-    y_offset = (max_height - rich_token.height()) / 2;
+    y_offset = (max_height - run.height()) / 2;
 
-    if (rich_token.type() == RichToken::Type::icon) {
+    if (run.type() == Run::Type::icon) {
       icon_font()->draw(
-        rich_token.icon_index(),
+        run.icon_index(),
         attr.bitmap(),
         top_left + Point(0, y_offset));
     } else {
-      text_font()->draw(
-        rich_token.value(),
-        attr.bitmap(),
-        top_left + Point(0, y_offset));
+      const StringView text = value()(StringView::GetSubstring()
+                                        .set_position(run.offset())
+                                        .set_length(run.length()));
+      if (blend_table) {
+        text_font()->draw(
+          text,
+          attr.bitmap(),
+          top_left + Point(0, y_offset),
+          *blend_table);
+      } else {
+        text_font()->draw(text, attr.bitmap(), top_left + Point(0, y_offset));
+      }
     }
 
-    top_left += Point(rich_token.width() + text_font()->space_size(), 0);
+    top_left += Point(run.width() + text_font()->space_size(), 0);
+  }
+}
+
+const RichText::RunList &RichText::get_run_list(RunList &scratch) const {
+  if (m_run_cache_capacity == 0) {
+    build_run_list(scratch);
+    return scratch;
   }
+
+  m_run_cache_access_count++;
+  const u64 key = calculate_key(text_font(), value());
+  for (RunList &run_list : m_run_cache) {
+    if (run_list.is_match(text_font(), icon_font(), key, value())) {
+      m_run_cache_hit_count++;
+      run_list.set_last_access(m_run_cache_access_count);
+      return run_list;
+    }
+  }
+
+  m_run_cache_miss_count++;
+
+  size_t offset = m_run_cache.count();
+  if (offset >= m_run_cache_capacity) {
+    // replace the least recently used list
+    offset = 0;
+    for (size_t i = 1; i < m_run_cache.count(); i++) {
+      const u32 last_access = m_run_cache.at(i).last_access();
+      if (last_access < m_run_cache.at(offset).last_access()) {
+        offset = i;
+      }
+    }
+  } else {
+    m_run_cache.push_back(RunList());
+  }
+
+  RunList &run_list = m_run_cache.at(offset);
+  run_list.set_key(key)
+    .set_string(value())
+    .set_last_access(m_run_cache_access_count);
+  build_run_list(run_list);
+  return run_list;
+}
+
+void RichText::build_run_list(RunList &run_list) const {
+  run_list.set_text_font(text_font())
+    .set_icon_font(icon_font())
+    .set_icon_font_revision(icon_font() ? icon_font()->revision() : 0)
+    .set_total_width(0)
+    .set_max_height(text_font()->get_height());
+  run_list.list().clear();
+
+  // runs are separated by spaces, icons are :<icon name>:
+  const var::StringView string = value();
+  size_t start = 0;
+  size_t position = 0;
+  for (const char c : string) {
+    position++;
+    if (c != ' ' && position < string.length()) {
+      continue;
+    }
+
+    const size_t end = c == ' ' ? position - 1 : position;
+    const var::StringView token
+      = string(StringView::GetSubstring().set_position(start).set_length(
+        end - start));
+
+    Run run;
+    run.set_offset(start).set_length(end - start);
+    if (
+      (token.length() > 2) && (token.front() == ':')
+      && (token.back() == ':')) {
+      const size_t icon_index
+        = icon_font()->find(token(StringView::GetSubstring()
+                                    .set_position(1)
+                                    .set_length(token.length() - 2)));
+      IconFont::IconInfo info = icon_font()->get_info(icon_index);
+      run.set_type(Run::Type::icon)
+        .set_icon_index(icon_index)
+        .set_width(info.width())
+        .set_height(info.height());
+      if (info.height() > run_list.max_height()) {
+        run_list.set_max_height(info.height());
+      }
+    } else {
+      run.set_width(text_font()->get_width(token))
+        .set_height(text_font()->get_height());
+    }
+
+    run_list.set_total_width(run_list.total_width() + run.width());
+    run_list.list().push_back(run);
+    start = position;
+  }
+
+  if (start == string.length() && string.length() && string.back() == ' ') {
+    // a trailing space ends with an empty run
+    Run run;
+    run.set_offset(start).set_height(text_font()->get_height());
+    run_list.list().push_back(run);
+  }
+}
+
+u64 RichText::calculate_key(
+  const sgfx::Font *font,
+  const var::StringView value) {
+  // FNV-1a
+  u64 result = 0xcbf29ce484222325ULL;
+  for (const char c : value) {
+    result = (result ^ u8(c)) * 0x100000001b3ULL;
+  }
+
+  // settings that change the width of the runs
+  const u64 settings = (u64(value.length()) << 32)
+                       | (font->is_kerning_enabled() ? 1 : 0);
+  return (result ^ settings) * 0x9E3779B97F4A7C15ULL;
 }
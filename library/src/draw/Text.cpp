@@ -2,6 +2,7 @@
 
 #include "ux/draw/Text.hpp"
 #include "ux/Assets.hpp"
+#include "ux/sgfx/TextRunCache.hpp"
 
 using namespace ux::sgfx;
 using namespace ux::draw;
@@ -65,10 +66,49 @@ void Text::draw(const DrawingScaledAttributes &attr) {
       top_left.y = p.y + d.height() / 2 - h / 2;
     }
 
-    font->draw(
-      string(),
-      attr.bitmap().set_pen(Pen().set_color(m_color).set_zero_transparent()),
-      top_left);
+    attr.bitmap().set_pen(Pen().set_color(m_color).set_zero_transparent());
+    draw_string(font, string(), attr, top_left);
+  }
+}
+
+const BlendTable *Text::get_blend_table(const Font *font) const {
+  if (m_blend_table) {
+    return m_blend_table;
+  }
+
+  if ((m_blend_theme == nullptr) || (font->is_antialiased() == false)) {
+    return nullptr;
+  }
+
+  const BlendTable *result = m_blend_theme->get_blend_table(
+    m_blend_style,
+    m_blend_state,
+    static_cast<BlendTable::BitsPerPixel>(font->bits_per_pixel()));
+  return result->is_valid() ? result : nullptr;
+}
+
+void Text::draw_string(
+  const sgfx::Font *font,
+  const var::StringView value,
+  const DrawingScaledAttributes &attr,
+  const sgfx::Point &point) const {
+  const BlendTable *blend_table = get_blend_table(font);
+  Point run_offset;
+  const Bitmap *run = TextRunCache::get(*font, value, run_offset);
+  if (run != nullptr) {
+    if (blend_table) {
+      blend_table->draw(
+        attr.bitmap(),
+        point + run_offset,
+        *run,
+        Region(Point(), run->area()));
+    } else {
+      attr.bitmap().draw_bitmap(point + run_offset, *run);
+    }
+  } else if (blend_table) {
+    font->draw(value, attr.bitmap(), point, *blend_table);
+  } else {
+    font->draw(value, attr.bitmap(), point);
   }
 }
 
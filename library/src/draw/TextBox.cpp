@@ -7,10 +7,65 @@
 using namespace ux::sgfx;
 using namespace ux::draw;
 
+var::Vector<sg_int_t> TextBox::m_advance_list;
+
 TextBox::TextBox() {}
 
 int TextBox::count_lines(sg_size_t width) {
-  return count_lines(this->font(), string(), width).line_count;
+  return update_line_list(width).count();
+}
+
+const var::Vector<TextBox::Line> &TextBox::update_line_list(sg_size_t width) {
+  // the font can also change when it is resolved by name
+  const Font *font = this->font();
+  if (
+    (m_line_revision == m_revision) && (font == m_line_font)
+    && (width == m_line_width)) {
+    return m_line_list;
+  }
+
+  m_line_revision = m_revision;
+  m_line_font = font;
+  m_line_width = width;
+  build_line_list(font, string(), width, m_line_list);
+  return m_line_list;
+}
+
+void TextBox::build_line_list(
+  const Font *font,
+  const var::StringView string,
+  sg_size_t width,
+  var::Vector<Line> &line_list) {
+  line_list.clear();
+  if (font == nullptr) {
+    return;
+  }
+
+  var::Vector<sg_int_t> &advance_list = m_advance_list;
+  size_t line_start = 0;
+  do {
+    size_t line_end = string.find("\n", line_start);
+    if (line_end == StringView::npos) {
+      line_end = string.length();
+    }
+
+    const StringView input_line = string.get_substring(
+      StringView::GetSubstring()
+        .set_position(line_start)
+        .set_length(line_end - line_start));
+    measure_line(font, input_line, advance_list);
+    size_t offset = 0;
+    do {
+      int len;
+      const size_t line_offset = offset;
+      const StringView line
+        = build_line(font, input_line, advance_list, offset, len, width);
+      line_list.push_back(
+        {u32(line_start + line_offset), u32(line.length()), sg_int_t(len)});
+    } while (offset < input_line.length());
+
+    line_start = line_end + 1;
+  } while (line_start <= string.length());
 }
 
 TextBox::CountLinesResult TextBox::count_lines(const Font *font,
@@ -23,14 +78,24 @@ TextBox::CountLinesResult TextBox::count_lines(const Font *font,
   }
 
   int num_lines = 0;
-  const StringViewList line_list = string.split("\n");
-  for (const StringView line : line_list) {
-    const StringViewList tokens = line.split(" ");
+  var::Vector<sg_int_t> &advance_list = m_advance_list;
+  size_t line_start = 0;
+  do {
+    size_t line_end = string.find("\n", line_start);
+    if (line_end == StringView::npos) {
+      line_end = string.length();
+    }
+
+    const StringView line = string.get_substring(
+      StringView::GetSubstring()
+        .set_position(line_start)
+        .set_length(line_end - line_start));
+    measure_line(font, line, advance_list);
     int len;
-    u32 i = 0;
+    size_t offset = 0;
     do {
-      GeneralString line_to_build;
-      const size_t character_count = build_line(font, i, line_to_build, tokens, len, width);
+      const size_t character_count
+        = build_line(font, line, advance_list, offset, len, width).length();
       if( result.characters_on_first_line == 0){
         result.characters_on_first_line = character_count;
       }
@@ -40,8 +105,10 @@ TextBox::CountLinesResult TextBox::count_lines(const Font *font,
         result.characters_on_last_line = character_count;
       }
       num_lines++;
-    } while (i < tokens.count());
-  }
+    } while (offset < line.length());
+
+    line_start = line_end + 1;
+  } while (line_start <= string.length());
 
   result.line_count = num_lines;
   return result;
@@ -49,12 +116,9 @@ TextBox::CountLinesResult TextBox::count_lines(const Font *font,
 
 void TextBox::draw(const DrawingScaledAttributes &attr) {
 
-  u32 i;
   const sg_point_t p = attr.point();
   const sg_area_t d = attr.area();
 
-  int len;
-
   // draw the message and wrap the text
   if (
     resolve_font(m_font_point_size == 0 ? d.height : m_font_point_size)
@@ -70,9 +134,7 @@ void TextBox::draw(const DrawingScaledAttributes &attr) {
  const sg_size_t width = d.width;
 
   const sg_size_t num_lines = count_lines(width);
-  if (num_lines < 0) {
-    return;
-  }
+  m_first_line_length = m_line_list.count() ? m_line_list.at(0).length : 0;
 
   const sg_size_t visible_lines = (d.height) / (font_height + line_spacing);
 
@@ -87,80 +149,85 @@ void TextBox::draw(const DrawingScaledAttributes &attr) {
     m_scroll = m_scroll_total;
   }
 
-  const StringViewList line_list = string().split("\n");
-  sg_int_t line_y = 0;
-  int lines_drawn = 0;
-  sg_point_t start{};
+  attr.bitmap().set_pen(Pen().set_color(m_color).set_zero_transparent());
+
+  // only the visible lines are drawn
   const auto y_spacing = font_height + line_spacing;
-  bool is_first_line_assigend = false;
-  for (const StringView input_line : line_list) {
-    const StringViewList tokens = input_line.split(" ");
-    i = 0;
-    do {
-      GeneralString line;
-      const auto character_length = build_line(font, i, line, tokens, len, width);
-      if( is_first_line_assigend == false ){
-        is_first_line_assigend = true;
-        m_first_line_length = character_length;
-      }
-      if (
-        (lines_drawn >= m_scroll) && (lines_drawn - m_scroll < visible_lines)) {
-        start.y = p.y + line_y;
-        if (is_align_left()) {
-          start.x = p.x;
-        } else if (is_align_right()) {
-          start.x = p.x + width - len;
-        } else {
-          start.x = p.x + (width - len) / 2;
-        }
-        font->draw(line, attr.bitmap(), start);
-        line_y += (y_spacing);
-      }
-      lines_drawn++;
-    } while (i < tokens.count());
+  sg_int_t line_y = 0;
+  for (size_t i = m_scroll;
+       (i < m_line_list.count()) && (i - m_scroll < visible_lines);
+       i++) {
+    const Line &line = m_line_list.at(i);
+    sg_point_t start;
+    start.y = p.y + line_y;
+    if (is_align_left()) {
+      start.x = p.x;
+    } else if (is_align_right()) {
+      start.x = p.x + width - line.width;
+    } else {
+      start.x = p.x + (width - line.width) / 2;
+    }
+    draw_string(
+      font,
+      string().get_substring(StringView::GetSubstring()
+                               .set_position(line.offset)
+                               .set_length(line.length)),
+      attr,
+      start);
+    line_y += y_spacing;
+  }
+}
+
+void TextBox::measure_line(
+  const Font *font,
+  const var::StringView line,
+  var::Vector<sg_int_t> &advance_list) {
+  if (advance_list.count() < line.length()) {
+    advance_list.resize(line.length());
   }
+  font->measure(line, advance_list.data(), line.length());
 }
 
-size_t TextBox::build_line(const Font *font,
-  u32 &token_position,
-  GeneralString &line,
-  const StringViewList &tokens,
+var::StringView TextBox::build_line(
+  const Font *font,
+  const var::StringView input_line,
+  const var::Vector<sg_int_t> &advance_list,
+  size_t &offset,
   int &build_len,
   sg_size_t width) {
-  build_len = 0;
-  size_t result = 0;
-
-  const u32 count = tokens.count();
-  for (u32 j = token_position; j < count; j++) {
-    const int line_len = font->get_width(line);
-    const int len = font->get_width(tokens.at(token_position));
-    if (line_len + len <= width) {
-      const auto token = tokens.at(j);
-      line |= token;
-      result += token.length();
-      token_position++;
+  const size_t start = offset;
+  const size_t length = input_line.length();
+  const sg_int_t *advance = advance_list.data();
+  const sg_int_t line_x = start > 0 ? advance[start - 1] : 0;
+
+  // bytes that fit on the line
+  size_t end
+    = start + Font::find_fit(advance + start, length - start, line_x + width);
+
+  if (end < length) {
+    // break after the last word that fits
+    size_t space = end;
+    while ((space > start) && (input_line.at(space) != ' ')) {
+      space--;
     }
 
-    if (len > width) {
-      // single word is too large to fit on one line
-      const auto token = tokens.at(j);
-      result += token.length();
-      line |= token;
-      token_position++;
-      break;
-    }
-
-    if ((line_len + len + font->space_size() <= width) && (j < (count - 1))) {
-      // there is room for another word -- add a space
-      line |= " ";
-      result++;
+    if ((space > start) || (input_line.at(start) == ' ')) {
+      end = space;
     } else {
-      break;
+      // a single word is too large to fit on one line
+      end = input_line.find(" ", start);
+      if (end == StringView::npos) {
+        end = length;
+      }
     }
   }
 
-  build_len = font->get_width(line);
+  // the space where the line breaks is not drawn
+  offset = end < length ? end + 1 : end;
 
-  //returns the number of characters used on the line
-  return result;
+  build_len = end > start ? advance[end - 1] - line_x : 0;
+
+  // returns the characters used on the line
+  return input_line.get_substring_at_position(start).get_substring_with_length(
+    end - start);
 }
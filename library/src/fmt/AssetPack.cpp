@@ -0,0 +1,174 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include <cstring>
+
+#include "ux/fmt/AssetPack.hpp"
+
+using namespace ux::sgfx;
+using namespace ux::fmt;
+
+AssetPack::AssetPack(MemoryMap &&memory_map)
+  : m_memory_map(std::move(memory_map)) {
+  API_RETURN_IF_ERROR();
+
+  const var::View view = m_memory_map.view();
+  if (view.size() < sizeof(header_t)) {
+    API_RETURN_ASSIGN_ERROR("asset pack is too small", EINVAL);
+  }
+
+  header_t header;
+  memcpy(&header, view.to_const_u8(), sizeof(header));
+  if ((header.signature != signature()) || (header.version != version())) {
+    API_RETURN_ASSIGN_ERROR("asset pack header is not valid", EINVAL);
+  }
+
+  if (sizeof(header) + header.entry_count * sizeof(entry_t) > view.size()) {
+    API_RETURN_ASSIGN_ERROR("asset pack index is not valid", EINVAL);
+  }
+
+  const entry_t *entry_list
+    = reinterpret_cast<const entry_t *>(view.to_const_u8() + sizeof(header));
+  for (u32 i = 0; i < header.entry_count; i++) {
+    const entry_t &entry = entry_list[i];
+    if (
+      (entry.offset > view.size()) || (entry.size > view.size() - entry.offset)
+      || (entry.name[sizeof(entry.name) - 1] != 0)) {
+      API_RETURN_ASSIGN_ERROR("asset pack entry is not valid", EINVAL);
+    }
+  }
+
+  // the index is used in place
+  m_entry_list = entry_list;
+  m_entry_count = header.entry_count;
+}
+
+AssetPack::Entry AssetPack::at(u32 offset) const {
+  if (offset >= m_entry_count) {
+    return Entry();
+  }
+  const entry_t *entry = m_entry_list + offset;
+  return Entry(
+    entry,
+    var::View(m_memory_map.view().to_const_u8() + entry->offset, entry->size));
+}
+
+int AssetPack::find(Type type) const {
+  const entry_t key = create_key(type, "", Font::Style::any, 0);
+  const u32 offset = find_lower_bound(key);
+  if ((offset < m_entry_count) && (m_entry_list[offset].type == key.type)) {
+    return offset;
+  }
+  return -1;
+}
+
+int AssetPack::find(Type type, const var::StringView name) const {
+  const entry_t key = create_key(type, name, Font::Style::any, 0);
+  const u32 offset = find_lower_bound(key);
+  if (offset < m_entry_count) {
+    const entry_t &entry = m_entry_list[offset];
+    if (
+      (entry.type == key.type)
+      && (strncmp(entry.name, key.name, sizeof(key.name)) == 0)) {
+      return offset;
+    }
+  }
+  return -1;
+}
+
+int AssetPack::find(
+  Type type,
+  const var::StringView name,
+  Font::Style style,
+  sg_size_t point_size) const {
+  const entry_t key = create_key(type, name, style, point_size);
+  const u32 offset = find_lower_bound(key);
+  if ((offset < m_entry_count) && (compare(m_entry_list[offset], key) == 0)) {
+    return offset;
+  }
+  return -1;
+}
+
+void AssetPack::save(
+  const fs::FileObject &file,
+  const var::Vector<Item> &item_list) {
+
+  // the item offset is kept in the entry until the index is sorted
+  var::Vector<entry_t> entry_list;
+  entry_list.reserve(item_list.count());
+  for (u32 i = 0; i < item_list.count(); i++) {
+    const Item &item = item_list.at(i);
+    entry_t entry = create_key(
+      item.type(),
+      item.name(),
+      item.type() == Type::icon_font ? Font::Style::icons : item.style(),
+      item.point_size());
+    entry.offset = i;
+    entry.size = item.data().size();
+    entry_list.push_back(entry);
+  }
+  entry_list.sort(is_less);
+
+  const header_t header
+    = {signature(), version(), static_cast<u16>(entry_list.count())};
+  file.write(var::View(header));
+
+  u32 data_offset = sizeof(header) + entry_list.count() * sizeof(entry_t);
+  for (entry_t entry : entry_list) {
+    entry.offset = data_offset;
+    data_offset += (entry.size + 3) & ~0x03;
+    file.write(var::View(entry));
+  }
+
+  const u32 padding = 0;
+  for (const entry_t &entry : entry_list) {
+    const var::View data = item_list.at(entry.offset).data();
+    file.write(data).write(var::View(&padding, (4 - data.size()) & 0x03));
+  }
+}
+
+AssetPack::entry_t AssetPack::create_key(
+  Type type,
+  const var::StringView name,
+  Font::Style style,
+  sg_size_t point_size) {
+  entry_t result = {};
+  var::View(result.name).pop_back().copy(name);
+  result.type = static_cast<u8>(type);
+  result.style = static_cast<u8>(style);
+  result.point_size = point_size;
+  return result;
+}
+
+int AssetPack::compare(const entry_t &a, const entry_t &b) {
+  if (a.type != b.type) {
+    return a.type < b.type ? -1 : 1;
+  }
+
+  const int result = strncmp(a.name, b.name, sizeof(a.name));
+  if (result != 0) {
+    return result;
+  }
+
+  if (a.style != b.style) {
+    return a.style < b.style ? -1 : 1;
+  }
+
+  if (a.point_size != b.point_size) {
+    return a.point_size < b.point_size ? -1 : 1;
+  }
+  return 0;
+}
+
+u32 AssetPack::find_lower_bound(const entry_t &key) const {
+  u32 low = 0;
+  u32 high = m_entry_count;
+  while (low < high) {
+    const u32 middle = (low + high) / 2;
+    if (compare(m_entry_list[middle], key) < 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
@@ -5,3 +5,7 @@
 using namespace ux::sgfx;
 
 SgfxApi Api::m_api;
+
+bool Api::is_api_valid() {
+  return m_api.is_valid() && (m_api->sos_api.version == SG_VERSION);
+}
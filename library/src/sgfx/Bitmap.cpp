@@ -7,6 +7,7 @@
 
 #include "fs/File.hpp"
 #include "ux/sgfx/Bitmap.hpp"
+#include "ux/sgfx/BitmapConverter.hpp"
 #include "ux/sgfx/Cursor.hpp"
 
 printer::Printer &
@@ -110,10 +111,30 @@ BitmapData &BitmapData::load(const fs::FileObject &file) {
 
   if (
     (hdr.version != api()->sos_api.version)
-    || (hdr.bits_per_pixel != api()->bits_per_pixel)) {
+    || (is_bits_per_pixel_valid(hdr.bits_per_pixel) == false)) {
     API_RETURN_VALUE_ASSIGN_ERROR(*this, "", EINVAL);
   }
 
+  if (api()->bits_per_pixel && (hdr.bits_per_pixel != api()->bits_per_pixel)) {
+    // the file is converted to the bits per pixel of the library
+    var::Data source(
+      sg_calc_word_width(hdr.width * hdr.bits_per_pixel) * hdr.height
+      * sizeof(sg_bmap_data_t));
+    file.read(source);
+    API_RETURN_VALUE_IF_ERROR(*this);
+
+    resize(
+      Area(hdr.width, hdr.height),
+      static_cast<BitsPerPixel>(api()->bits_per_pixel));
+    API_RETURN_VALUE_IF_ERROR(*this);
+
+    BitmapConverter().convert(
+      source,
+      static_cast<BitsPerPixel>(hdr.bits_per_pixel),
+      *this);
+    return *this;
+  }
+
   resize(
     Area(hdr.width, hdr.height),
     static_cast<BitsPerPixel>(hdr.bits_per_pixel));
@@ -143,13 +164,27 @@ Area BitmapData::load_area(const fs::FileObject &file) {
   file.read(View(hdr));
   if (
     (hdr.version != api()->sos_api.version)
-    || (hdr.bits_per_pixel != api()->bits_per_pixel)) {
+    || (is_bits_per_pixel_valid(hdr.bits_per_pixel) == false)) {
     return Area();
   }
 
   return Area(hdr.width, hdr.height);
 }
 
+bool Bitmap::is_bits_per_pixel_valid(u8 bits_per_pixel) {
+  switch (bits_per_pixel) {
+  case 1:
+  case 2:
+  case 4:
+  case 8:
+  case 16:
+  case 32:
+    return true;
+  default:
+    return false;
+  }
+}
+
 u32 Bitmap::color_count() const {
   return 1 << static_cast<u8>(bits_per_pixel());
 }
@@ -188,8 +223,8 @@ void Bitmap::initialize_members(
   const Area &area,
   BitsPerPixel bits_per_pixel) {
 
-  // ensure api() is valid
-  if (api().is_valid() == false) {
+  // ensure api() is valid and has the functions this library calls
+  if (is_api_valid() == false) {
     exit_fatal("sgfx api not available");
   }
 
@@ -398,3 +433,77 @@ Region Bitmap::fill_empty_region(Area area) {
 
   return Region();
 }
+
+MappedBitmap::MappedBitmap(MemoryMap &&memory_map)
+  : m_memory_map(std::move(memory_map)) {
+  API_RETURN_IF_ERROR();
+
+  const var::View view = m_memory_map.view();
+  if (view.size() < sizeof(sg_bmap_header_t)) {
+    API_RETURN_ASSIGN_ERROR("bitmap file is too small", EINVAL);
+  }
+
+  sg_bmap_header_t header;
+  memcpy(&header, view.to_const_u8(), sizeof(header));
+
+  if (Bitmap::is_bits_per_pixel_valid(header.bits_per_pixel) == false) {
+    API_RETURN_ASSIGN_ERROR("bitmap bits per pixel is not valid", EINVAL);
+  }
+
+  const size_t data_size = sg_calc_word_width(
+                             header.width * header.bits_per_pixel)
+                           * header.height * sizeof(sg_bmap_data_t);
+
+  if (
+    (header.version != api()->sos_api.version)
+    || (view.size() - sizeof(header) < data_size)) {
+    API_RETURN_ASSIGN_ERROR("bitmap header is not valid", EINVAL);
+  }
+
+  m_header = header;
+  m_data = var::View(view.to_const_u8() + sizeof(header), data_size);
+
+  const bool is_aligned
+    = (reinterpret_cast<uintptr_t>(m_data.to_const_void())
+       % sizeof(sg_bmap_data_t))
+      == 0;
+
+  const bool is_bits_per_pixel_supported
+    = (api()->bits_per_pixel == 0)
+      || (api()->bits_per_pixel == header.bits_per_pixel);
+
+  if (is_aligned && is_bits_per_pixel_supported) {
+    // the bitmap is read-only but sg_bmap_t does not have a const data member
+    m_bitmap = Bitmap(
+      var::View(const_cast<void *>(m_data.to_const_void()), m_data.size()),
+      area(),
+      bits_per_pixel());
+    m_is_zero_copy = true;
+    m_is_ready = true;
+  }
+}
+
+const Bitmap &MappedBitmap::bitmap() const {
+  if (m_is_ready == false) {
+    convert();
+  }
+  return m_bitmap;
+}
+
+void MappedBitmap::convert() const {
+  m_is_ready = true;
+  if (is_valid() == false) {
+    return;
+  }
+
+  const auto target_bits_per_pixel = static_cast<BitsPerPixel>(
+    api()->bits_per_pixel ? api()->bits_per_pixel : m_header.bits_per_pixel);
+
+  m_converted.resize(area(), target_bits_per_pixel);
+  API_RETURN_IF_ERROR();
+
+  BitmapConverter().convert(m_data, bits_per_pixel(), m_converted);
+  API_RETURN_IF_ERROR();
+
+  m_bitmap = m_converted;
+}
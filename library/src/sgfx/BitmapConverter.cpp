@@ -0,0 +1,111 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include <var.hpp>
+
+#include "ux/sgfx/BitmapConverter.hpp"
+
+using namespace ux::sgfx;
+
+BitmapConverter &BitmapConverter::set_palette(
+  const Palette &source,
+  const Palette &destination) {
+  m_color_map.resize(source.colors().count());
+  for (u32 i = 0; i < source.colors().count(); i++) {
+    m_color_map.at(i) = find_nearest(destination, source.palette_color(i));
+  }
+  return *this;
+}
+
+const BitmapConverter &BitmapConverter::convert(
+  const var::View source,
+  BitsPerPixel source_bits_per_pixel,
+  const Bitmap &destination) const {
+  const u8 bits_per_pixel = static_cast<u8>(source_bits_per_pixel);
+  const size_t source_size = sg_calc_word_width(
+                               destination.width() * bits_per_pixel)
+                             * destination.height() * sizeof(sg_bmap_data_t);
+
+  if (source.size() < source_size) {
+    API_RETURN_VALUE_ASSIGN_ERROR(*this, "source is too small", EINVAL);
+  }
+
+  const bool is_color_map = m_color_map.count() > 0;
+  if (
+    is_color_map
+    && ((bits_per_pixel > 16)
+        || (m_color_map.count() < (1U << bits_per_pixel)))) {
+    API_RETURN_VALUE_ASSIGN_ERROR(*this, "color map is too small", EINVAL);
+  }
+
+  api()->convert_bmap_data(
+    destination.bmap()->data,
+    destination.bmap()->bits_per_pixel,
+    source.to_const_void(),
+    bits_per_pixel,
+    destination.area(),
+    is_color_map ? m_color_map.data() : nullptr);
+
+  return *this;
+}
+
+BitmapData
+BitmapConverter::convert(const Bitmap &source, BitsPerPixel bits_per_pixel)
+  const {
+  BitmapData result(source.area(), bits_per_pixel);
+  API_RETURN_VALUE_IF_ERROR(result);
+  convert(
+    var::View(source.bmap()->data, source.calculate_size()),
+    source.bits_per_pixel(),
+    result);
+  return result;
+}
+
+BitmapData BitmapConverter::load(
+  const fs::FileObject &file,
+  BitsPerPixel bits_per_pixel) const {
+  sg_bmap_header_t header = {};
+  file.read(var::View(header));
+  API_RETURN_VALUE_IF_ERROR(BitmapData());
+
+  if (
+    (header.version != api()->sos_api.version)
+    || (Bitmap::is_bits_per_pixel_valid(header.bits_per_pixel) == false)) {
+    API_RETURN_VALUE_ASSIGN_ERROR(BitmapData(), "", EINVAL);
+  }
+
+  var::Data source(
+    sg_calc_word_width(header.width * header.bits_per_pixel) * header.height
+    * sizeof(sg_bmap_data_t));
+  file.read(source);
+  API_RETURN_VALUE_IF_ERROR(BitmapData());
+
+  BitmapData result(Area(header.width, header.height), bits_per_pixel);
+  API_RETURN_VALUE_IF_ERROR(result);
+  convert(
+    source,
+    static_cast<BitsPerPixel>(header.bits_per_pixel),
+    result);
+  return result;
+}
+
+u32 BitmapConverter::find_nearest(
+  const Palette &palette,
+  const PaletteColor &color) {
+  u32 result = 0;
+  u32 best_distance = 0xffffffff;
+  for (u32 i = 0; i < palette.colors().count(); i++) {
+    const PaletteColor entry = palette.palette_color(i);
+    const s32 red = s32(entry.red()) - color.red();
+    const s32 green = s32(entry.green()) - color.green();
+    const s32 blue = s32(entry.blue()) - color.blue();
+    const u32 distance = red * red + green * green + blue * blue;
+    if (distance < best_distance) {
+      best_distance = distance;
+      result = i;
+      if (distance == 0) {
+        break;
+      }
+    }
+  }
+  return result;
+}
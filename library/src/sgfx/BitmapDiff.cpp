@@ -0,0 +1,108 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include "ux/sgfx/BitmapDiff.hpp"
+
+using namespace ux::sgfx;
+
+BitmapDiff::BitmapDiff(
+  const Bitmap &previous,
+  const Bitmap &current,
+  const Options &options) {
+  if (
+    (previous.width() != current.width())
+    || (previous.height() != current.height())
+    || (previous.bits_per_pixel() != current.bits_per_pixel())) {
+    API_RETURN_ASSIGN_ERROR("bitmaps do not match", EINVAL);
+  }
+
+  Region band;
+  bool is_band = false;
+  for (sg_int_t y = 0; y < current.height(); y++) {
+    sg_int_t x_first;
+    sg_int_t x_last;
+    const u32 count = api()->calc_bmap_row_diff(
+      previous.bmap(),
+      current.bmap(),
+      y,
+      &x_first,
+      &x_last);
+
+    if (count == 0) {
+      continue;
+    }
+
+    m_changed_pixel_count += count;
+    m_changed_row_count++;
+
+    const Region row(Point(x_first, y), Area(x_last - x_first + 1, 1));
+    if (is_band && (calculate_merge_cost(band, row) <= options.merge_cost())) {
+      band = band.calculate_bounds(row);
+    } else {
+      if (is_band) {
+        add_region(band, options);
+      }
+      band = row;
+      is_band = true;
+    }
+  }
+
+  if (is_band) {
+    add_region(band, options);
+  }
+}
+
+u32 BitmapDiff::calculate_region_pixel_count() const {
+  u32 result = 0;
+  for (const Region &region : m_region_list) {
+    result += region.width() * region.height();
+  }
+  return result;
+}
+
+Region BitmapDiff::calculate_bounds() const {
+  if (m_region_list.count() == 0) {
+    return Region();
+  }
+  Region result = m_region_list.at(0);
+  for (const Region &region : m_region_list) {
+    result = result.calculate_bounds(region);
+  }
+  return result;
+}
+
+u32 BitmapDiff::calculate_merge_cost(const Region &a, const Region &b) {
+  const Region merged = a.calculate_bounds(b);
+  const s32 cost = s32(merged.width() * merged.height())
+                   - s32(a.width() * a.height()) - s32(b.width() * b.height());
+  // overlapping regions are always merged
+  return cost > 0 ? cost : 0;
+}
+
+void BitmapDiff::add_region(Region region, const Options &options) {
+  // the list is never longer than maximum_region_count() so adding a
+  // band only compares it with a few regions
+  while (m_region_list.count() > 0) {
+    u32 best_cost = 0xffffffff;
+    u32 best_offset = 0;
+    for (u32 i = 0; i < m_region_list.count(); i++) {
+      const u32 cost = calculate_merge_cost(m_region_list.at(i), region);
+      if (cost < best_cost) {
+        best_cost = cost;
+        best_offset = i;
+      }
+    }
+
+    if (
+      (best_cost > options.merge_cost())
+      && (m_region_list.count() < options.maximum_region_count())) {
+      break;
+    }
+
+    // the merged region may now be cheap to merge with another one
+    region = m_region_list.at(best_offset).calculate_bounds(region);
+    m_region_list.at(best_offset) = m_region_list.back();
+    m_region_list.pop_back();
+  }
+
+  m_region_list.push_back(region);
+}
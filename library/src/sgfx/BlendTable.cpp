@@ -0,0 +1,54 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include "ux/sgfx/BlendTable.hpp"
+#include "ux/sgfx/BitmapConverter.hpp"
+
+using namespace ux::sgfx;
+
+BlendTable::BlendTable(
+  const Palette &palette,
+  sg_color_t color,
+  BitsPerPixel coverage_bits_per_pixel)
+  : m_color(color),
+    m_coverage_bits_per_pixel(static_cast<u8>(coverage_bits_per_pixel)) {
+  const u32 color_count = palette.colors().count();
+  const u32 level_count = 1 << m_coverage_bits_per_pixel;
+  const float max_coverage = level_count - 1;
+
+  if ((color_count > 256) || (color >= color_count)) {
+    // the table is left invalid (see is_valid()); text is then drawn
+    // without blending so this is not an error
+    return;
+  }
+
+  const PaletteColor foreground = palette.palette_color(color);
+  m_color_map.resize(color_count * level_count);
+  for (u32 background = 0; background < color_count; background++) {
+    const PaletteColor background_color = palette.palette_color(background);
+    m_color_map.at(background * level_count) = background;
+    for (u32 coverage = 1; coverage < level_count; coverage++) {
+      m_color_map.at(background * level_count + coverage)
+        = BitmapConverter::find_nearest(
+          palette,
+          background_color.blend(foreground, coverage / max_coverage));
+    }
+  }
+}
+
+const BlendTable &BlendTable::draw(
+  Bitmap &dest,
+  const Point &point,
+  const Bitmap &canvas,
+  const Region &region) const {
+  const sg_blend_table_t blend_table = table();
+  sg_glyph_t glyph;
+  glyph.point = point.point();
+  glyph.region = region.region();
+  api()->draw_blended_glyph_run(
+    dest.bmap(),
+    canvas.bmap(),
+    &glyph,
+    1,
+    &blend_table);
+  return *this;
+}
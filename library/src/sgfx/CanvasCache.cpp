@@ -0,0 +1,91 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include "ux/sgfx/CanvasCache.hpp"
+
+using namespace ux::sgfx;
+
+var::Vector<CanvasCache::Entry> CanvasCache::m_entry_list;
+size_t CanvasCache::m_budget = 16 * 1024;
+u32 CanvasCache::m_access_count = 0;
+u32 CanvasCache::m_hit_count = 0;
+u32 CanvasCache::m_miss_count = 0;
+
+const Bitmap *CanvasCache::get(
+  const fs::FileObject *file,
+  u32 offset,
+  const Area &area,
+  BitsPerPixel bits_per_pixel) {
+  m_access_count++;
+
+  for (Entry &entry : m_entry_list) {
+    if (entry.is_match(file, offset)) {
+      m_hit_count++;
+      entry.set_last_access(m_access_count);
+      return &entry.bitmap();
+    }
+  }
+
+  m_miss_count++;
+
+  BitmapData bitmap(area, bits_per_pixel);
+  API_RETURN_VALUE_IF_ERROR(nullptr);
+
+  file->seek(offset).read(bitmap.view());
+  API_RETURN_VALUE_IF_ERROR(nullptr);
+
+  make_room(bitmap.view().size());
+  m_entry_list.push_back(Entry(file, offset, std::move(bitmap)));
+  m_entry_list.back().set_last_access(m_access_count);
+  return &m_entry_list.back().bitmap();
+}
+
+void CanvasCache::remove(const fs::FileObject *file) {
+  size_t i = 0;
+  while (i < m_entry_list.count()) {
+    if (m_entry_list.at(i).file() == file) {
+      remove_entry(i);
+    } else {
+      i++;
+    }
+  }
+}
+
+void CanvasCache::clear() { m_entry_list = var::Vector<Entry>(); }
+
+void CanvasCache::set_budget(size_t value) {
+  m_budget = value;
+  make_room(0);
+}
+
+size_t CanvasCache::calculate_size() {
+  size_t result = 0;
+  for (const Entry &entry : m_entry_list) {
+    result += entry.size();
+  }
+  return result;
+}
+
+void CanvasCache::make_room(size_t size) {
+  size_t total = calculate_size();
+  while (m_entry_list.count() && (total + size > m_budget)) {
+    // discard the least recently used canvas
+    size_t oldest = 0;
+    for (size_t i = 1; i < m_entry_list.count(); i++) {
+      if (
+        m_entry_list.at(i).last_access()
+        < m_entry_list.at(oldest).last_access()) {
+        oldest = i;
+      }
+    }
+    total -= m_entry_list.at(oldest).size();
+    remove_entry(oldest);
+  }
+}
+
+void CanvasCache::remove_entry(size_t offset) {
+  // order does not matter
+  if (offset != m_entry_list.count() - 1) {
+    std::swap(m_entry_list.at(offset), m_entry_list.back());
+  }
+  m_entry_list.pop_back();
+}
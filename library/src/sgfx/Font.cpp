@@ -7,7 +7,10 @@
 #include <fs/Path.hpp>
 #include <var.hpp>
 
+#include "ux/sgfx/BlendTable.hpp"
+#include "ux/sgfx/CanvasCache.hpp"
 #include "ux/sgfx/Font.hpp"
+#include "ux/sgfx/TextRunCache.hpp"
 
 using namespace ux::sgfx;
 
@@ -81,6 +84,9 @@ Font::Info::Info(const var::StringView path) {
 }
 
 var::StringView Font::Info::get_name() const {
+  if (m_name.is_empty() == false) {
+    return m_name;
+  }
   const auto file_name = fs::Path::name(m_file_path);
   const size_t pos = file_name.find("-");
   if (pos != StringView::npos) {
@@ -103,11 +109,48 @@ var::StringView Font::ascii_character_set() {
          "abcdefghijklmnopqrstuvwxyz{|}~";
 }
 
-int Font::to_charset(char ascii) {
-  if ((ascii < ' ') || (ascii > '~')) {
+int Font::to_charset(u32 unicode) {
+  if ((unicode < ' ') || (unicode > '~')) {
     return -1;
   }
-  return (int)(ascii - ' ' - 1);
+  return (int)(unicode - ' ' - 1);
+}
+
+u32 Font::decode_utf8(const var::StringView value, size_t &offset) {
+  const u8 lead = value.at(offset++);
+  if (lead < 0x80) {
+    return lead;
+  }
+
+  u32 result;
+  u32 continuation_count;
+  if ((lead & 0xe0) == 0xc0) {
+    result = lead & 0x1f;
+    continuation_count = 1;
+  } else if ((lead & 0xf0) == 0xe0) {
+    result = lead & 0x0f;
+    continuation_count = 2;
+  } else if ((lead & 0xf8) == 0xf0) {
+    result = lead & 0x07;
+    continuation_count = 3;
+  } else {
+    return replacement_character();
+  }
+
+  for (u32 i = 0; i < continuation_count; i++) {
+    if (offset >= value.length()) {
+      return replacement_character();
+    }
+    const u8 next = value.at(offset);
+    if ((next & 0xc0) != 0x80) {
+      // the next byte starts a new code point
+      return replacement_character();
+    }
+    result = (result << 6) | (next & 0x3f);
+    offset++;
+  }
+
+  return result;
 }
 
 Font::Font(const fs::FileObject *file) : m_file(file) {
@@ -117,22 +160,148 @@ Font::Font(const fs::FileObject *file) : m_file(file) {
   refresh();
 }
 
+Font::Font(MemoryMap &&memory_map) : m_memory_map(std::move(memory_map)) {
+  API_RETURN_IF_ERROR();
+
+  const var::View view = m_memory_map.view();
+  if (view.size() < sizeof(sg_font_header_t)) {
+    API_RETURN_ASSIGN_ERROR("font is too small", EINVAL);
+  }
+
+  sg_font_header_t header;
+  memcpy(&header, view.to_const_u8(), sizeof(header));
+
+  sg_font_unicode_header_t unicode_header = {};
+  size_t range_start = sizeof(header);
+  if (header.version & SG_FONT_VERSION_FLAG_IS_UNICODE) {
+    if (view.size() < sizeof(header) + sizeof(unicode_header)) {
+      API_RETURN_ASSIGN_ERROR("font is too small", EINVAL);
+    }
+    memcpy(
+      &unicode_header,
+      view.to_const_u8() + sizeof(header),
+      sizeof(unicode_header));
+    range_start += sizeof(unicode_header);
+  } else {
+    unicode_header.character_count = header.character_count;
+  }
+
+  const size_t kerning_start
+    = range_start
+      + unicode_header.range_count * sizeof(sg_font_unicode_range_t);
+  const size_t character_start
+    = kerning_start
+      + header.kerning_pair_count * sizeof(sg_font_kerning_pair_t);
+  const size_t table_size
+    = character_start
+      + unicode_header.character_count * sizeof(sg_font_char_t);
+
+  if (
+    (header.size < table_size) || (header.size > view.size())
+    || (Bitmap::is_bits_per_pixel_valid(header.bits_per_pixel) == false)) {
+    API_RETURN_ASSIGN_ERROR("font header is not valid", EINVAL);
+  }
+
+  const u8 *data = view.to_const_u8();
+  m_is_zero_copy = (reinterpret_cast<uintptr_t>(data + header.size)
+                    % sizeof(sg_bmap_data_t))
+                   == 0;
+
+  if (m_is_zero_copy == false) {
+    // canvases must be word aligned to be drawn in place; the copy is
+    // padded so that the canvases (not the header) land on a word
+    const size_t padding
+      = (sizeof(sg_bmap_data_t) - header.size % sizeof(sg_bmap_data_t))
+        % sizeof(sg_bmap_data_t);
+    m_aligned_data = var::Data(padding + view.size());
+    var::View(m_aligned_data).pop_front(padding).copy(view);
+    data = m_aligned_data.data_u8() + padding;
+  }
+
+  m_header = header;
+  m_character_start = character_start;
+  m_character_count = unicode_header.character_count;
+  m_range_count = unicode_header.range_count;
+  m_range_data = reinterpret_cast<const sg_font_unicode_range_t *>(
+    data + range_start);
+  m_kerning_pair_data = reinterpret_cast<const sg_font_kerning_pair_t *>(
+    data + kerning_start);
+  m_character_data
+    = reinterpret_cast<const sg_font_char_t *>(data + character_start);
+
+  m_canvas_start = m_header.size;
+  m_canvas_size = sg_calc_word_width(
+                    m_header.canvas_width * m_header.bits_per_pixel)
+                  * m_header.canvas_height * sizeof(sg_bmap_data_t);
+  m_canvas_view
+    = var::View(data + m_header.size, view.size() - m_header.size);
+
+  build_kerning_index();
+
+  set_space_size(m_header.max_word_width * 8);
+  set_letter_spacing(m_header.max_height / 8);
+}
+
+Font::~Font() {
+  if (m_file != nullptr) {
+    CanvasCache::remove(m_file);
+  }
+  if (is_valid()) {
+    TextRunCache::remove(source());
+  }
+}
+
 void Font::refresh() {
 
+  // canvases and runs drawn before the refresh may be stale
+  CanvasCache::remove(m_file);
+  TextRunCache::remove(m_file);
+  m_kerning_pair_data = nullptr;
+  m_character_data = nullptr;
+  m_range_data = nullptr;
+  m_character_page_list = var::Vector<CharacterPage>();
+
   m_file->seek(0).read(View(m_header));
 
-  m_canvas.resize(
-    Area(m_header.canvas_width, m_header.canvas_height),
-    static_cast<Bitmap::BitsPerPixel>(m_header.bits_per_pixel));
+  // unicode fonts have code point ranges before the kerning pairs
+  m_range_list = var::Vector<sg_font_unicode_range_t>();
+  if (is_unicode()) {
+    sg_font_unicode_header_t unicode_header = {};
+    m_file->read(View(unicode_header));
+    m_character_count = unicode_header.character_count;
+    m_range_list.resize(unicode_header.range_count);
+    m_file->read(View(m_range_list));
+  } else {
+    m_character_count = m_header.character_count;
+  }
+  m_range_count = m_range_list.count();
+  m_range_data = m_range_list.data();
 
-  m_current_canvas = 255;
   m_canvas_start = m_header.size;
-  m_canvas_size = m_canvas.view().size();
+  m_canvas_size = sg_calc_word_width(
+                    m_header.canvas_width * m_header.bits_per_pixel)
+                  * m_header.canvas_height * sizeof(sg_bmap_data_t);
 
   m_kerning_pairs = var::Vector<sg_font_kerning_pair_t>();
   m_kerning_pairs.resize(m_header.kerning_pair_count);
 
-  m_file->seek(sizeof(sg_font_header_t)).read(View(m_kerning_pairs));
+  m_file->read(View(m_kerning_pairs));
+  m_kerning_pair_data = m_kerning_pairs.data();
+
+  // the character metrics follow the kerning pairs
+  m_character_start
+    = sizeof(sg_font_header_t)
+      + (is_unicode() ? sizeof(sg_font_unicode_header_t) : 0)
+      + m_range_count * sizeof(sg_font_unicode_range_t)
+      + m_header.kerning_pair_count * sizeof(sg_font_kerning_pair_t);
+  m_character_list = var::Vector<sg_font_char_t>();
+  if (is_unicode() == false) {
+    m_character_list.resize(m_character_count);
+    m_file->read(View(m_character_list));
+    m_character_data = m_character_list.data();
+  }
+
+  build_kerning_index();
 
   set_space_size(m_header.max_word_width * 8);
   set_letter_spacing(m_header.max_height / 8);
@@ -142,32 +311,118 @@ void Font::refresh() {
 
 int Font::get_width(const var::StringView str) const {
   u32 length = 0;
-  for (auto c : str) {
-    if (c == ' ') {
-      length += space_size();
+  size_t offset = 0;
+  while (offset < str.length()) {
+    length += get_advance(decode_utf8(str, offset));
+  }
+  return length;
+}
+
+size_t Font::measure(
+  const var::StringView str,
+  sg_int_t *advance_list,
+  size_t count) const {
+  const size_t length = str.length() < count ? str.length() : count;
+  sg_int_t x = 0;
+  size_t offset = 0;
+  while (offset < length) {
+    const size_t start = offset;
+    const u32 c = decode_utf8(str, offset);
+    x += get_advance(c);
+    if (is_kerning_enabled() && (offset < str.length())) {
+      size_t next_offset = offset;
+      x -= load_kerning(c, decode_utf8(str, next_offset));
+    }
+
+    const size_t end = offset < length ? offset : length;
+    for (size_t i = start; i < end; i++) {
+      advance_list[i] = x;
+    }
+  }
+  return length;
+}
+
+size_t Font::find_fit(
+  const sg_int_t *advance_list,
+  size_t count,
+  sg_int_t width) {
+  // the first entry that is past the width
+  size_t low = 0;
+  size_t high = count;
+  while (low < high) {
+    const size_t middle = (low + high) / 2;
+    if (advance_list[middle] <= width) {
+      low = middle + 1;
     } else {
-      if (load_char(m_char, c, true) == 0) {
-        length += m_char.advance_x;
+      high = middle;
+    }
+  }
+  return low;
+}
+
+Region Font::calculate_bounds(const var::StringView str) const {
+  sg_int_t x_min = 0;
+  sg_int_t y_min = 0;
+  sg_int_t x_max = 0;
+  sg_int_t y_max = 0;
+  bool is_empty = true;
+  sg_int_t x = 0;
+
+  size_t offset = 0;
+  while (offset < str.length()) {
+    const u32 c = decode_utf8(str, offset);
+    const sg_font_char_t *ch = (c == ' ') ? nullptr : find_character(c);
+    if (ch != nullptr) {
+      const sg_int_t left = x + ch->offset_x;
+      const sg_int_t top = ch->offset_y;
+      const sg_int_t right = left + ch->width;
+      const sg_int_t bottom = top + ch->height;
+      if (is_empty || (left < x_min)) {
+        x_min = left;
+      }
+      if (is_empty || (top < y_min)) {
+        y_min = top;
+      }
+      if (is_empty || (right > x_max)) {
+        x_max = right;
       }
+      if (is_empty || (bottom > y_max)) {
+        y_max = bottom;
+      }
+      is_empty = false;
+    }
+
+    int w = ch ? ch->advance_x : get_advance(c);
+    if (is_kerning_enabled() && (offset < str.length())) {
+      size_t next_offset = offset;
+      w -= load_kerning(c, decode_utf8(str, next_offset));
     }
+    x += w;
   }
-  return length;
+
+  if (is_empty) {
+    return Region();
+  }
+
+  return Region(Point(x_min, y_min), Area(x_max - x_min, y_max - y_min));
 }
 
-const Font &Font::draw(char c, Bitmap &dest, const Point &point) const {
-  if (load_char(m_char, c, true) < 0) {
+const Font &
+Font::draw(u32 unicode, Bitmap &dest, const Point &point) const {
+  const sg_font_char_t *ch = find_character(unicode);
+  if (ch == nullptr) {
     return *this;
   }
 
+  m_char = *ch;
   Point p = point + Point(m_char.offset_x, m_char.offset_y);
   draw_char_on_bitmap(m_char, dest, p);
   return *this;
 }
 
 sg_font_char_t Font::character(u32 offset) {
-  sg_font_char_t result = {0};
-  load_char(result, offset, false);
-  return result;
+  const sg_font_char_t *result = load_character(offset);
+  return result ? *result : sg_font_char_t{0};
 }
 
 #if defined NOT_BUILDING
@@ -187,71 +442,341 @@ const Font &Font::draw(
   const var::StringView const_string,
   Bitmap &bitmap,
   const Point &point) const {
+  draw_string(const_string, bitmap, point, nullptr);
+  return *this;
+}
+
+const Font &Font::draw(
+  const var::StringView const_string,
+  Bitmap &bitmap,
+  const Point &point,
+  const BlendTable &blend_table) const {
+  const sg_blend_table_t table = blend_table.table();
+  draw_string(const_string, bitmap, point, &table);
+  return *this;
+}
+
+void Font::draw_string(
+  const var::StringView const_string,
+  Bitmap &bitmap,
+  const Point &point,
+  const sg_blend_table_t *blend_table) const {
+  sg_glyph_t glyph_list[glyph_batch_size];
+  u8 canvas_list[glyph_batch_size];
+  u32 count = 0;
   sg_int_t w;
 
-  // draw characters on the bitmap
+  // lay out the characters then draw them one canvas at a time
   Point p(point); // copy that can be advanced
 
-  for (u32 i = 0; i < const_string.length(); i++) {
-    char c = const_string.at(i);
-    char d;
-    if (i < const_string.length() - 1) {
-      d = const_string.at(i + 1);
-    } else {
-      d = 0;
-    }
+  size_t offset = 0;
+  while (offset < const_string.length()) {
+    const u32 c = decode_utf8(const_string, offset);
     if (c == ' ') {
       w = space_size();
     } else {
-      draw(c, bitmap, p);
-      w = m_char.advance_x;
+      const sg_font_char_t *ch = find_character(c);
+      if (ch != nullptr) {
+        m_char = *ch;
+        sg_glyph_t &glyph = glyph_list[count];
+        glyph.point = (p + Point(ch->offset_x, ch->offset_y)).point();
+        glyph.region = Region(
+                         Point(ch->canvas_x, ch->canvas_y),
+                         Area(ch->width, ch->height))
+                         .region();
+        canvas_list[count] = ch->canvas_idx;
+        count++;
+      }
+      w = ch ? m_char.advance_x : 0;
     }
 
     // apply kerning
-    if (is_kerning_enabled() && (d != 0)) {
-      w -= load_kerning(c, d);
+    if (is_kerning_enabled() && (offset < const_string.length())) {
+      size_t next_offset = offset;
+      w -= load_kerning(c, decode_utf8(const_string, next_offset));
     }
 
     p += Point(w, 0);
+
+    if (count == glyph_batch_size) {
+      draw_glyph_batch(glyph_list, canvas_list, count, bitmap, blend_table);
+      count = 0;
+    }
   }
 
-  return *this;
+  draw_glyph_batch(glyph_list, canvas_list, count, bitmap, blend_table);
+}
+
+void Font::draw_glyph_batch(
+  const sg_glyph_t *glyph_list,
+  const u8 *canvas_list,
+  u32 count,
+  Bitmap &dest,
+  const sg_blend_table_t *blend_table) const {
+  sg_glyph_t run[glyph_batch_size];
+  u32 pending = count == glyph_batch_size ? 0xffffffff : (1UL << count) - 1;
+
+  while (pending) {
+    u32 first = 0;
+    while ((pending & (1UL << first)) == 0) {
+      first++;
+    }
+
+    // every glyph on the same canvas is drawn with one call
+    const u8 canvas_idx = canvas_list[first];
+    u32 run_count = 0;
+    for (u32 i = first; i < count; i++) {
+      if ((pending & (1UL << i)) && (canvas_list[i] == canvas_idx)) {
+        run[run_count++] = glyph_list[i];
+        pending &= ~(1UL << i);
+      }
+    }
+
+    Bitmap canvas;
+    if (load_canvas(canvas_idx, canvas) == false) {
+      continue;
+    }
+
+    if (blend_table) {
+      api()->draw_blended_glyph_run(
+        dest.bmap(),
+        canvas.bmap(),
+        run,
+        run_count,
+        blend_table);
+    } else {
+      api()->draw_glyph_run(dest.bmap(), canvas.bmap(), run, run_count);
+    }
+  }
 }
 
 sg_size_t Font::get_height() const { return m_header.max_height; }
 sg_size_t Font::get_width() const { return m_header.max_word_width * 32; }
 
-int Font::load_char(sg_font_char_t &ch, char c, bool ascii) const {
-  int ind;
-  if (ascii) {
-    ind = to_charset(c);
-  } else {
-    ind = c;
+const sg_font_char_t *Font::find_character(u32 unicode) const {
+  const int offset = find_character_offset(unicode);
+  return offset < 0 ? nullptr : load_character(offset);
+}
+
+int Font::find_character_offset(u32 unicode) const {
+  if (is_unicode() == false) {
+    const int index = to_charset(unicode);
+    return ((index < 0) || (u32(index) >= m_character_count)) ? -1 : index;
+  }
+
+  // find the last range that starts at or before the code point
+  u32 low = 0;
+  u32 high = m_range_count;
+  while (low < high) {
+    const u32 middle = (low + high) / 2;
+    if (m_range_data[middle].first <= unicode) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
   }
 
-  if (ind < 0) {
+  if (low == 0) {
     return -1;
   }
 
-  const size_t offset
-    = sizeof(sg_font_header_t)
-      + sizeof(sg_font_kerning_pair_t) * m_header.kerning_pair_count
-      + ind * sizeof(sg_font_char_t);
+  const sg_font_unicode_range_t &range = m_range_data[low - 1];
+  if (unicode - range.first >= range.count) {
+    return -1;
+  }
 
-  m_file->seek(offset).read(View(ch));
+  const u32 result = range.character_offset + (unicode - range.first);
+  return result < m_character_count ? int(result) : -1;
+}
 
-  return 0;
+const sg_font_char_t *Font::load_character(u32 offset) const {
+  if (offset >= m_character_count) {
+    return nullptr;
+  }
+
+  if (m_character_data != nullptr) {
+    return m_character_data + offset;
+  }
+
+  return load_character_page(offset);
 }
 
-int Font::load_kerning(u16 first, u16 second) const {
-  int kerning_count = m_header.kerning_pair_count;
-  int i;
+const sg_font_char_t *Font::load_character_page(u32 offset) const {
+  const u32 page_offset = offset - offset % character_page_size;
+  m_character_page_access++;
+
+  for (CharacterPage &page : m_character_page_list) {
+    if (page.offset == page_offset && page.list.count()) {
+      page.last_access = m_character_page_access;
+      return &page.list.at(offset - page_offset);
+    }
+  }
+
+  // reuse the least recently used page once all pages are in use
+  size_t target = 0;
+  if (m_character_page_list.count() < maximum_character_page_count) {
+    m_character_page_list.push_back(CharacterPage());
+    target = m_character_page_list.count() - 1;
+  } else {
+    for (size_t i = 1; i < m_character_page_list.count(); i++) {
+      if (
+        m_character_page_list.at(i).last_access
+        < m_character_page_list.at(target).last_access) {
+        target = i;
+      }
+    }
+  }
+
+  CharacterPage &page = m_character_page_list.at(target);
+  const u32 remaining = m_character_count - page_offset;
+  page.offset = page_offset;
+  page.last_access = m_character_page_access;
+  page.list.resize(
+    remaining < character_page_size ? remaining : character_page_size);
+
+  m_file->seek(m_character_start + page_offset * sizeof(sg_font_char_t))
+    .read(View(page.list));
+
+  if (is_error()) {
+    page.list = var::Vector<sg_font_char_t>();
+    return nullptr;
+  }
+
+  return &page.list.at(offset - page_offset);
+}
+
+void Font::build_kerning_index() {
+  m_kerning_table = var::Vector<s8>();
+  m_kerning_index = var::Vector<u16>();
+
+  const u32 count = m_character_count;
+  const u32 pair_count = m_header.kerning_pair_count;
+  if ((count == 0) || (pair_count == 0)) {
+    return;
+  }
+
+  bool is_sorted = true;
+  for (u32 i = 1; i < pair_count; i++) {
+    if (ascending_kerning_pair(
+          m_kerning_pair_data[i],
+          m_kerning_pair_data[i - 1])) {
+      is_sorted = false;
+      break;
+    }
+  }
+
+  if (is_sorted == false) {
+    if (m_kerning_pairs.count() != pair_count) {
+      // pairs used in place are read-only so they are copied to be sorted
+      m_kerning_pairs.resize(pair_count);
+      var::View(m_kerning_pairs)
+        .copy(var::View(
+          m_kerning_pair_data,
+          pair_count * sizeof(sg_font_kerning_pair_t)));
+    }
+    m_kerning_pairs.sort(ascending_kerning_pair);
+    m_kerning_pair_data = m_kerning_pairs.data();
+  }
+
+  if ((m_canvas_view.size() > 0) || is_unicode()) {
+    // fonts used in place search all the sorted pairs rather than
+    // using the heap for an index (as do unicode fonts where the
+    // pairs cannot be indexed by character)
+    return;
+  }
+
+  bool is_dense_possible = true;
+  for (u32 i = 0; i < pair_count; i++) {
+    const s16 kerning = m_kerning_pair_data[i].horizontal_kerning;
+    if ((kerning < -128) || (kerning > 127)) {
+      is_dense_possible = false;
+      break;
+    }
+  }
+
+  // small fonts use a dense table if it is not much larger than the pairs
+  const u32 dense_size = count * count;
+  const u32 pair_size = pair_count * sizeof(sg_font_kerning_pair_t);
+  if (is_dense_possible && (dense_size <= pair_size * 2)) {
+    m_kerning_table.resize(dense_size).fill(0);
+    for (u32 i = 0; i < pair_count; i++) {
+      const sg_font_kerning_pair_t &pair = m_kerning_pair_data[i];
+      const int first = to_charset(pair.unicode_first);
+      const int second = to_charset(pair.unicode_second);
+      if (
+        (first >= 0) && (second >= 0) && (u32(first) < count)
+        && (u32(second) < count)) {
+        m_kerning_table.at(first * count + second) = pair.horizontal_kerning;
+      }
+    }
+    return;
+  }
+
+  // otherwise the sorted pairs are indexed by the first character
+  m_kerning_index.resize(count + 1);
+  u32 offset = 0;
+  for (u32 i = 0; i <= count; i++) {
+    while (
+      (offset < pair_count)
+      && (to_charset(m_kerning_pair_data[offset].unicode_first) < int(i))) {
+      offset++;
+    }
+    m_kerning_index.at(i) = offset;
+  }
+}
+
+bool Font::ascending_kerning_pair(
+  const sg_font_kerning_pair_t &a,
+  const sg_font_kerning_pair_t &b) {
+  if (a.unicode_first == b.unicode_first) {
+    return a.unicode_second < b.unicode_second;
+  }
+  return a.unicode_first < b.unicode_first;
+}
+
+int Font::load_kerning(u32 first, u32 second) const {
+  if ((first > 0xffff) || (second > 0xffff)) {
+    // kerning pairs only have 16-bit code points
+    return 0;
+  }
+
+  // binary search the sorted pairs (only those that start with the
+  // first character if the pairs are indexed)
+  u32 low = 0;
+  u32 high = m_kerning_pair_data ? m_header.kerning_pair_count : 0;
+
+  if (m_kerning_table.count() || m_kerning_index.count()) {
+    const int first_index = to_charset(first);
+    const int second_index = to_charset(second);
+    const u32 count = m_character_count;
 
-  for (i = 0; i < kerning_count; i++) {
     if (
-      (m_kerning_pairs.at(i).unicode_first == first)
-      && (m_kerning_pairs[i].unicode_second == second)) {
-      return m_kerning_pairs.at(i).horizontal_kerning;
+      (first_index < 0) || (second_index < 0) || (u32(first_index) >= count)
+      || (u32(second_index) >= count)) {
+      return 0;
+    }
+
+    if (m_kerning_table.count()) {
+      return m_kerning_table.at(first_index * count + second_index);
+    }
+
+    low = m_kerning_index.at(first_index);
+    high = m_kerning_index.at(first_index + 1);
+  }
+
+  sg_font_kerning_pair_t key = {};
+  key.unicode_first = first;
+  key.unicode_second = second;
+  while (low < high) {
+    const u32 middle = (low + high) / 2;
+    const sg_font_kerning_pair_t &pair = m_kerning_pair_data[middle];
+    if ((pair.unicode_first == first) && (pair.unicode_second == second)) {
+      return pair.horizontal_kerning;
+    }
+    if (ascending_kerning_pair(pair, key)) {
+      low = middle + 1;
+    } else {
+      high = middle;
     }
   }
 
@@ -259,8 +784,10 @@ int Font::load_kerning(u16 first, u16 second) const {
 }
 
 sg_font_kerning_pair_t Font::load_kerning(u32 offset) const {
-  if (offset < m_header.kerning_pair_count) {
-    return m_kerning_pairs[offset];
+  if (
+    (m_kerning_pair_data != nullptr)
+    && (offset < m_header.kerning_pair_count)) {
+    return m_kerning_pair_data[offset];
   }
   return {0};
 }
@@ -269,15 +796,45 @@ void Font::draw_char_on_bitmap(
   const sg_font_char_t &ch,
   Bitmap &dest,
   const Point &point) const {
-
-  if (ch.canvas_idx != m_current_canvas) {
-    const size_t canvas_offset = m_canvas_start + ch.canvas_idx * m_canvas_size;
-    m_file->seek(canvas_offset).read(m_canvas.view());
-    m_current_canvas = ch.canvas_idx;
+  Bitmap canvas;
+  if (load_canvas(ch.canvas_idx, canvas) == false) {
+    return;
   }
 
   dest.draw_sub_bitmap(
     point,
-    m_canvas,
+    canvas,
     Region(Point(ch.canvas_x, ch.canvas_y), Area(ch.width, ch.height)));
 }
+
+bool Font::load_canvas(u32 canvas_idx, Bitmap &canvas) const {
+  const size_t offset = canvas_idx * m_canvas_size;
+
+  if (m_file == nullptr) {
+    if (offset + m_canvas_size > m_canvas_view.size()) {
+      return false;
+    }
+
+    // the canvas is read-only but sg_bmap_t does not have a const data member
+    canvas = Bitmap(
+      var::View(
+        const_cast<u8 *>(m_canvas_view.to_const_u8()) + offset,
+        m_canvas_size),
+      Area(m_header.canvas_width, m_header.canvas_height),
+      static_cast<Bitmap::BitsPerPixel>(m_header.bits_per_pixel));
+    return true;
+  }
+
+  const Bitmap *cached = CanvasCache::get(
+    m_file,
+    m_canvas_start + offset,
+    Area(m_header.canvas_width, m_header.canvas_height),
+    static_cast<Bitmap::BitsPerPixel>(m_header.bits_per_pixel));
+
+  if (cached == nullptr) {
+    return false;
+  }
+
+  canvas = *cached;
+  return true;
+}
@@ -3,6 +3,7 @@
 #include <printer/Printer.hpp>
 #include <var.hpp>
 
+#include "ux/sgfx/CanvasCache.hpp"
 #include "ux/sgfx/IconFont.hpp"
 
 namespace printer {
@@ -17,6 +18,8 @@ operator<<(Printer &printer, const ux::sgfx::IconFont::IconInfo &info) {
 
 using namespace ux::sgfx;
 
+u32 IconFont::m_revision_count = 0;
+
 #if defined NOT_BUILDING
 IconFont::FontInfo::FontInfo(const var::StringView  path) {
   m_path = fs::Path(path);
@@ -37,17 +40,52 @@ IconFont::FontInfo::FontInfo(const var::StringView  path) {
 
 IconFont::IconFont(const fs::FileObject *file) : m_file(file) { refresh(); }
 
+IconFont::~IconFont() {
+  if (m_file != nullptr) {
+    CanvasCache::remove(m_file);
+  }
+}
+
 size_t IconFont::find(const var::StringView  name) const {
-  for (size_t i = 0; i < m_list.count(); i++) {
-    if (this->get_info(i).name() == name) {
-      return i;
+  const u32 hash = calculate_hash(name);
+
+  size_t low = 0;
+  size_t high = m_name_index.count();
+  while (low < high) {
+    const size_t middle = (low + high) / 2;
+    if (m_name_index.at(middle).hash < hash) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  // names only need to be compared if the hashes collide
+  for (size_t i = low; i < m_name_index.count(); i++) {
+    const NameHash &entry = m_name_index.at(i);
+    if (entry.hash != hash) {
+      break;
+    }
+    if (this->get_info(entry.offset).name() == name) {
+      return entry.offset;
     }
   }
   return m_list.count();
 }
 
+u32 IconFont::calculate_hash(const var::StringView name) {
+  // FNV-1a
+  u32 result = 0x811c9dc5;
+  for (const char c : name) {
+    result = (result ^ u8(c)) * 0x01000193;
+  }
+  return result;
+}
+
 IconFont &IconFont::refresh() {
   m_list.clear();
+  m_name_index.clear();
+  CanvasCache::remove(m_file);
   m_file->seek(0).read(var::View(m_header));
 
   for (u32 i = 0; i < m_header.icon_count; i++) {
@@ -60,10 +98,16 @@ IconFont &IconFont::refresh() {
     m_list.push_back(icon);
   }
 
-  m_master_canvas_idx = -1;
-  m_master_canvas.resize(
-    Area(m_header.canvas_width, m_header.canvas_height),
-    static_cast<Bitmap::BitsPerPixel>(m_header.bits_per_pixel));
+  m_name_index.reserve(m_list.count());
+  for (u32 i = 0; i < m_list.count(); i++) {
+    m_name_index.push_back({calculate_hash(get_info(i).name()), i});
+  }
+  m_name_index.sort(is_less);
+  m_revision = ++m_revision_count;
+
+  m_canvas_size = sg_calc_word_width(
+                    m_header.canvas_width * m_header.bits_per_pixel)
+                  * m_header.canvas_height * sizeof(sg_bmap_data_t);
 
   return *this;
 }
@@ -73,17 +117,19 @@ IconFont::draw(size_t offset, Bitmap &dest, const Point &point) const {
   API_ASSERT(offset < m_list.count());
   const sg_font_icon_t &icon = m_list.at(offset);
 
-  if (icon.canvas_idx != m_master_canvas_idx) {
-    const u32 file_offset
-      = m_header.size + icon.canvas_idx * m_master_canvas.view().size();
+  const Bitmap *canvas = CanvasCache::get(
+    m_file,
+    m_header.size + icon.canvas_idx * m_canvas_size,
+    Area(m_header.canvas_width, m_header.canvas_height),
+    bits_per_pixel());
 
-    m_file->seek(file_offset).read(m_master_canvas.view());
-    m_master_canvas_idx = icon.canvas_idx;
+  if (canvas == nullptr) {
+    return *this;
   }
 
   dest.draw_sub_bitmap(
     point,
-    m_master_canvas,
+    *canvas,
     Region(Point(icon.canvas_x, icon.canvas_y), Area(icon.width, icon.height)));
 
   return *this;
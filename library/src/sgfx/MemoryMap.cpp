@@ -0,0 +1,58 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#if defined __link && !defined __win32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UX_MEMORY_MAP_IS_MMAP 1
+#else
+#define UX_MEMORY_MAP_IS_MMAP 0
+#endif
+
+#include <fs/File.hpp>
+#include <var/StackString.hpp>
+
+#include "ux/sgfx/MemoryMap.hpp"
+
+using namespace ux::sgfx;
+
+MemoryMap::MemoryMap(const var::StringView path) {
+#if UX_MEMORY_MAP_IS_MMAP
+  const var::PathString path_string(path);
+  const int fd = ::open(path_string.cstring(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat st = {};
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+      void *address
+        = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address != MAP_FAILED) {
+        m_address = address;
+        m_mapped_size = st.st_size;
+        m_view = var::View(static_cast<const void *>(address), m_mapped_size);
+      }
+    }
+    ::close(fd);
+    if (m_address != nullptr) {
+      return;
+    }
+  }
+#endif
+
+  // fallback: read the entire file into memory once
+  fs::File file(path);
+  API_RETURN_IF_ERROR();
+  m_data.resize(file.size());
+  API_RETURN_IF_ERROR();
+  file.read(m_data);
+  API_RETURN_IF_ERROR();
+  m_view = var::View(m_data);
+}
+
+MemoryMap::~MemoryMap() {
+#if UX_MEMORY_MAP_IS_MMAP
+  if (m_address != nullptr) {
+    ::munmap(m_address, m_mapped_size);
+  }
+#endif
+}
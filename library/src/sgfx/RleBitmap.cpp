@@ -0,0 +1,245 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include <var.hpp>
+
+#include "ux/sgfx/RleBitmap.hpp"
+
+using namespace ux::sgfx;
+
+namespace {
+
+u32 run_word(u16 count, u16 color) {
+  sg_rle_run_t run;
+  run.count = count;
+  run.color = color;
+  u32 result;
+  memcpy(&result, &run, sizeof(result));
+  return result;
+}
+
+sg_color_t get_pixel(const sg_bmap_t *bmap, sg_int_t x, sg_int_t y) {
+  const u32 bit_offset = x * bmap->bits_per_pixel;
+  const sg_bmap_data_t word
+    = bmap->data[y * bmap->columns + bit_offset / 32];
+  const u32 mask = bmap->bits_per_pixel == 32
+                     ? 0xffffffffUL
+                     : (1UL << bmap->bits_per_pixel) - 1;
+  return (word >> (bit_offset % 32)) & mask;
+}
+
+void append_literal(
+  var::Vector<u32> &runs,
+  const sg_bmap_t *bmap,
+  sg_int_t y,
+  sg_int_t x_start,
+  sg_int_t x_end) {
+  if (x_end <= x_start) {
+    return;
+  }
+  const u8 bits_per_pixel = bmap->bits_per_pixel;
+  runs.push_back(
+    run_word(u16((x_end - x_start) | SG_RLE_RUN_FLAG_IS_LITERAL), 0));
+
+  // pack the pixels LSB first just like sg_bmap_t
+  u32 word = 0;
+  u32 shift = 0;
+  for (sg_int_t x = x_start; x < x_end; x++) {
+    word |= get_pixel(bmap, x, y) << shift;
+    shift += bits_per_pixel;
+    if (shift == 32) {
+      runs.push_back(word);
+      word = 0;
+      shift = 0;
+    }
+  }
+  if (shift) {
+    runs.push_back(word);
+  }
+}
+
+} // namespace
+
+RleBitmap::RleBitmap(const var::View view) { set_view(view); }
+
+void RleBitmap::set_view(const var::View view) {
+  m_view = var::View();
+  m_rle_bmap = {};
+  if (view.size() == 0) {
+    return;
+  }
+
+  if (view.size() < sizeof(sg_rle_bmap_header_t)) {
+    API_RETURN_ASSIGN_ERROR("rle bitmap is too small", EINVAL);
+  }
+
+  if (
+    (reinterpret_cast<uintptr_t>(view.to_const_void()) % sizeof(u32)) != 0) {
+    API_RETURN_ASSIGN_ERROR("rle bitmap is not word aligned", EINVAL);
+  }
+
+  sg_rle_bmap_header_t header;
+  memcpy(&header, view.to_const_u8(), sizeof(header));
+
+  if (Bitmap::is_bits_per_pixel_valid(header.bits_per_pixel) == false) {
+    API_RETURN_ASSIGN_ERROR("rle bitmap bits per pixel is not valid", EINVAL);
+  }
+
+  const size_t index_size = header.height * sizeof(u32);
+  if (
+    (header.signature != SG_RLE_BMAP_SIGNATURE)
+    || (header.version != api()->sos_api.version)
+    || (view.size() - sizeof(header) < header.size)
+    || (header.size < index_size)) {
+    API_RETURN_ASSIGN_ERROR("rle bitmap header is not valid", EINVAL);
+  }
+
+  const u32 *row_offsets = reinterpret_cast<const u32 *>(
+    view.to_const_u8() + sizeof(header));
+  const sg_bmap_data_t *runs = reinterpret_cast<const sg_bmap_data_t *>(
+    view.to_const_u8() + sizeof(header) + index_size);
+  const size_t run_words = (header.size - index_size) / sizeof(u32);
+
+  // check every row once so drawing does not need bounds checks
+  for (sg_size_t y = 0; y < header.height; y++) {
+    if (row_offsets[y] % sizeof(u32)) {
+      API_RETURN_ASSIGN_ERROR("rle bitmap row is not word aligned", EINVAL);
+    }
+    size_t offset = row_offsets[y] / sizeof(u32);
+    u32 x = 0;
+    while (x < header.width) {
+      if (offset >= run_words) {
+        API_RETURN_ASSIGN_ERROR("rle bitmap row overflows", EINVAL);
+      }
+      sg_rle_run_t run;
+      memcpy(&run, runs + offset, sizeof(run));
+      const u32 count = run.count & SG_RLE_RUN_COUNT_MASK;
+      if (count == 0) {
+        API_RETURN_ASSIGN_ERROR("rle bitmap run is empty", EINVAL);
+      }
+      offset++;
+      if (run.count & SG_RLE_RUN_FLAG_IS_LITERAL) {
+        offset += sg_calc_word_width(count * header.bits_per_pixel);
+      }
+      x += count;
+    }
+    if ((x != header.width) || (offset > run_words)) {
+      API_RETURN_ASSIGN_ERROR("rle bitmap row is not valid", EINVAL);
+    }
+  }
+
+  m_view = var::View(view.to_const_u8(), sizeof(header) + header.size);
+  m_rle_bmap.area = sg_dim(header.width, header.height);
+  m_rle_bmap.bits_per_pixel = header.bits_per_pixel;
+  m_rle_bmap.row_offsets = row_offsets;
+  m_rle_bmap.runs = runs;
+}
+
+const RleBitmap &RleBitmap::save(const fs::FileObject &file) const {
+  file.write(m_view);
+  return *this;
+}
+
+RleBitmapData::RleBitmapData(const Bitmap &bitmap) {
+  const sg_bmap_t *bmap = bitmap.bmap();
+  const u8 bits_per_pixel = bmap->bits_per_pixel;
+  const sg_int_t width = bmap->area.width;
+  const sg_int_t height = bmap->area.height;
+
+  // a solid run must save at least two words of literal pixels
+  const sg_int_t minimum_solid_run
+    = bits_per_pixel >= 32 ? 2 : (2 * 32) / bits_per_pixel;
+
+  var::Vector<u32> row_offsets;
+  var::Vector<u32> runs;
+  row_offsets.resize(height);
+
+  for (sg_int_t y = 0; y < height; y++) {
+    row_offsets.at(y) = runs.count() * sizeof(u32);
+    sg_int_t literal_start = 0;
+    sg_int_t x = 0;
+    while (x < width) {
+      const sg_color_t color = get_pixel(bmap, x, y);
+      sg_int_t count = 1;
+      while ((x + count < width) && (count < SG_RLE_RUN_COUNT_MASK)
+             && (get_pixel(bmap, x + count, y) == color)) {
+        count++;
+      }
+
+      if ((count >= minimum_solid_run) && (color <= 0xffff)) {
+        append_literal(runs, bmap, y, literal_start, x);
+        runs.push_back(run_word(u16(count), u16(color)));
+        x += count;
+        literal_start = x;
+      } else {
+        if (x + count - literal_start > SG_RLE_RUN_COUNT_MASK) {
+          append_literal(runs, bmap, y, literal_start, x);
+          literal_start = x;
+        }
+        x += count;
+      }
+    }
+    append_literal(runs, bmap, y, literal_start, width);
+  }
+
+  const size_t index_size = row_offsets.count() * sizeof(u32);
+  const size_t runs_size = runs.count() * sizeof(u32);
+  sg_rle_bmap_header_t header = {};
+  header.width = bmap->area.width;
+  header.height = bmap->area.height;
+  header.size = u32(index_size + runs_size);
+  header.bits_per_pixel = bits_per_pixel;
+  header.version = u16(api()->sos_api.version);
+  header.signature = SG_RLE_BMAP_SIGNATURE;
+
+  m_data.resize(sizeof(header) + header.size);
+  API_RETURN_IF_ERROR();
+
+  u8 *destination = var::View(m_data).to_u8();
+  memcpy(destination, &header, sizeof(header));
+  memcpy(destination + sizeof(header), row_offsets.to_const_void(), index_size);
+  memcpy(
+    destination + sizeof(header) + index_size,
+    runs.to_const_void(),
+    runs_size);
+
+  set_view(m_data);
+}
+
+RleBitmapData &RleBitmapData::load(const fs::FileObject &file) {
+  sg_rle_bmap_header_t header = {};
+  file.read(var::View(header));
+  API_RETURN_VALUE_IF_ERROR(*this);
+
+  if (header.signature != SG_RLE_BMAP_SIGNATURE) {
+    API_RETURN_VALUE_ASSIGN_ERROR(*this, "", EINVAL);
+  }
+
+  m_data.resize(sizeof(header) + header.size);
+  API_RETURN_VALUE_IF_ERROR(*this);
+
+  var::View view(m_data);
+  memcpy(view.to_void(), &header, sizeof(header));
+  file.read(view.pop_front(sizeof(header)));
+  API_RETURN_VALUE_IF_ERROR(*this);
+
+  set_view(m_data);
+  return *this;
+}
+
+const Bitmap &
+Bitmap::draw_bitmap(const Point &p_dest, const RleBitmap &src) const {
+  api()->draw_rle_bitmap(bmap(), p_dest, src.rle_bmap());
+  return *this;
+}
+
+const Bitmap &Bitmap::draw_sub_bitmap(
+  const Point &destination_point,
+  const RleBitmap &source_bitmap,
+  const Region &source_region) const {
+  api()->draw_sub_rle_bitmap(
+    bmap(),
+    destination_point,
+    source_bitmap.rle_bmap(),
+    &source_region.region());
+  return *this;
+}
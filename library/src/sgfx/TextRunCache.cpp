@@ -0,0 +1,128 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include "ux/sgfx/TextRunCache.hpp"
+
+using namespace ux::sgfx;
+
+var::Vector<TextRunCache::Entry> TextRunCache::m_entry_list;
+size_t TextRunCache::m_budget = 0;
+u32 TextRunCache::m_access_count = 0;
+u32 TextRunCache::m_hit_count = 0;
+u32 TextRunCache::m_miss_count = 0;
+
+const Bitmap *TextRunCache::get(
+  const Font &font,
+  const var::StringView string,
+  Point &offset) {
+  if (is_enabled() == false || font.is_valid() == false) {
+    return nullptr;
+  }
+
+  m_access_count++;
+
+  const u64 key = calculate_key(font, string);
+  for (Entry &entry : m_entry_list) {
+    if (entry.is_match(font.source(), key, string)) {
+      m_hit_count++;
+      entry.set_last_access(m_access_count);
+      offset = entry.offset();
+      return &entry.bitmap();
+    }
+  }
+
+  m_miss_count++;
+
+  const Region bounds = font.calculate_bounds(string);
+  if (bounds.width() == 0 || bounds.height() == 0) {
+    return nullptr;
+  }
+
+  BitmapData bitmap(
+    bounds.area(),
+    static_cast<Bitmap::BitsPerPixel>(font.bits_per_pixel()));
+  API_RETURN_VALUE_IF_ERROR(nullptr);
+
+  bitmap.clear();
+  bitmap.set_pen(Pen().set_color(1).set_zero_transparent());
+  font.draw(string, bitmap, Point() - bounds.point());
+
+  const size_t size = bitmap.view().size() + string.length();
+  if (size > m_budget) {
+    // the run would push everything else out of the cache
+    return nullptr;
+  }
+
+  make_room(size);
+  m_entry_list.push_back(
+    Entry(font.source(), key, string, bounds.point(), std::move(bitmap)));
+  m_entry_list.back().set_last_access(m_access_count);
+  offset = bounds.point();
+  return &m_entry_list.back().bitmap();
+}
+
+void TextRunCache::remove(const void *source) {
+  size_t i = 0;
+  while (i < m_entry_list.count()) {
+    if (m_entry_list.at(i).source() == source) {
+      remove_entry(i);
+    } else {
+      i++;
+    }
+  }
+}
+
+void TextRunCache::clear() { m_entry_list = var::Vector<Entry>(); }
+
+void TextRunCache::set_budget(size_t value) {
+  m_budget = value;
+  make_room(0);
+}
+
+size_t TextRunCache::calculate_size() {
+  size_t result = 0;
+  for (const Entry &entry : m_entry_list) {
+    result += entry.size();
+  }
+  return result;
+}
+
+u64 TextRunCache::calculate_key(
+  const Font &font,
+  const var::StringView string) {
+  // FNV-1a
+  u64 result = 0xcbf29ce484222325ULL;
+  for (const char c : string) {
+    result = (result ^ u8(c)) * 0x100000001b3ULL;
+  }
+
+  // settings that change where the glyphs are drawn
+  const u64 settings = (u64(string.length()) << 32)
+                       | (u64(u16(font.space_size())) << 1)
+                       | (font.is_kerning_enabled() ? 1 : 0);
+  return (result ^ settings) * 0x9E3779B97F4A7C15ULL;
+}
+
+void TextRunCache::make_room(size_t size) {
+  size_t total = calculate_size();
+  while (m_entry_list.count() && (total + size > m_budget)) {
+    // discard the least recently used run
+    size_t oldest = 0;
+    for (size_t i = 1; i < m_entry_list.count(); i++) {
+      if (
+        m_entry_list.at(i).last_access()
+        < m_entry_list.at(oldest).last_access()) {
+        oldest = i;
+      }
+    }
+    total -= m_entry_list.at(oldest).size();
+    remove_entry(oldest);
+  }
+}
+
+void TextRunCache::remove_entry(size_t offset) {
+  // order does not matter
+  if (offset != m_entry_list.count() - 1) {
+    std::swap(m_entry_list.at(offset), m_entry_list.back());
+  }
+  m_entry_list.pop_back();
+}
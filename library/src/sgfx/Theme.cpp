@@ -121,6 +121,7 @@ size_t Theme::calculate_color_offset(Style style, State state) const {
 Theme &Theme::set_bits_per_pixel(u8 bits_per_pixel) {
   m_header.bits_per_pixel = bits_per_pixel;
   m_color_count = header_color_count();
+  m_blend_table_list = var::Vector<BlendTableEntry>();
   m_current_palette
     .set_pixel_format(static_cast<Palette::PixelFormat>(m_header.pixel_format))
     .set_color_count(static_cast<Palette::ColorCount>(m_color_count));
@@ -131,6 +132,7 @@ Theme &Theme::write_palette(Style style, State state, const Palette &palette) {
   API_ASSERT(m_color_count == palette.colors().count());
   m_color_file.seek(calculate_color_offset(style, state))
     .write(palette.colors());
+  m_blend_table_list = var::Vector<BlendTableEntry>();
   return *this;
 }
 
@@ -143,6 +145,7 @@ const Palette &Theme::read_palette(Style style, State state) const {
 Theme &Theme::load(const var::StringView path) {
   m_color_file = std::move(fs::File(path).read(var::View(m_header)));
   m_color_count = header_color_count();
+  m_blend_table_list = var::Vector<BlendTableEntry>();
   m_current_palette
     .set_pixel_format(Palette::PixelFormat(m_header.pixel_format))
     .set_color_count(Palette::ColorCount(m_color_count));
@@ -164,6 +167,7 @@ Theme &Theme::create(
     = std::move(fs::File(is_overwrite, path).write(var::View(m_header)));
 
   m_color_count = header_color_count();
+  m_blend_table_list = var::Vector<BlendTableEntry>();
 
   m_current_palette
     .set_pixel_format(Palette::PixelFormat(m_header.pixel_format))
@@ -172,6 +176,38 @@ Theme &Theme::create(
   return *this;
 }
 
+BlendTable Theme::create_blend_table(
+  Style style,
+  State state,
+  BitsPerPixel coverage_bits_per_pixel) const {
+  return BlendTable(
+    read_palette(style, state),
+    text_color(),
+    coverage_bits_per_pixel);
+}
+
+const BlendTable *Theme::get_blend_table(
+  Style style,
+  State state,
+  BitsPerPixel coverage_bits_per_pixel) const {
+  const u32 key = (calculate_color_offset(style, state) << 8)
+                  | static_cast<u32>(coverage_bits_per_pixel);
+  for (const BlendTableEntry &entry : m_blend_table_list) {
+    if (entry.key == key) {
+      return &entry.table;
+    }
+  }
+
+  if (m_blend_table_list.count() == maximum_blend_table_count) {
+    // the first table is the oldest
+    m_blend_table_list.remove(0);
+  }
+
+  m_blend_table_list.push_back(
+    {key, create_blend_table(style, state, coverage_bits_per_pixel)});
+  return &m_blend_table_list.back().table;
+}
+
 const Theme &Theme::set_display_palette(
   const Display &display,
   Style style,
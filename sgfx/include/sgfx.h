@@ -61,9 +61,65 @@ void sg_bmap_set_data(
 sg_bmap_data_t *sg_bmap_data(const sg_bmap_t *bmap, sg_point_t p);
 size_t sg_calc_bmap_size(const sg_bmap_t *bmap, sg_area_t area);
 
+/*! \details Calculates a 64-bit hash of the pixels in a region
+ * of the bitmap.
+ *
+ * @param bmap The bitmap to hash
+ * @param region The region to hash (truncated to the bitmap)
+ *
+ * The bitmap is processed one word at a time. Pixels outside the region
+ * do not affect the result, so equal regions in different bitmaps (or at
+ * different positions) have the same hash.
+ *
+ */
+u64 sg_calc_bmap_hash(const sg_bmap_t *bmap, const sg_region_t *region);
+
+/*! \details Compares one row of two bitmaps that have the same
+ * dimensions and bits per pixel.
+ *
+ * @param a The first bitmap
+ * @param b The second bitmap
+ * @param y The row to compare
+ * @param x_first Assigned the first changed pixel in the row (-1 if none)
+ * @param x_last Assigned the last changed pixel in the row (-1 if none)
+ * @return The number of pixels that are different
+ *
+ */
+u32 sg_calc_bmap_row_diff(
+  const sg_bmap_t *a,
+  const sg_bmap_t *b,
+  sg_int_t y,
+  sg_int_t *x_first,
+  sg_int_t *x_last);
+
 static inline u16 sg_calc_word_width(sg_size_t w) { return (w + 31) >> 5; }
 
 void sg_bmap_show(const sg_bmap_t *bmap);
+
+/*! \details Converts packed bitmap data from one bits per pixel
+ * value to another.
+ *
+ * @param dest The destination data (sg_calc_word_width(width * dest bpp)
+ * words per row)
+ * @param dest_bits_per_pixel The destination bits per pixel (1, 2, 4, 8, 16,
+ * 32)
+ * @param src The source data (does not need to be word aligned)
+ * @param src_bits_per_pixel The source bits per pixel (1, 2, 4, 8, 16, 32)
+ * @param area The width and height of both bitmaps
+ * @param color_map Maps each source color to a destination color (1 <<
+ * src_bits_per_pixel entries) or null
+ *
+ * If \a color_map is null, colors keep the most significant bits when
+ * reducing the bits per pixel and keep the same value when increasing them.
+ *
+ */
+void sg_convert_bmap_data(
+  sg_bmap_data_t *dest,
+  u8 dest_bits_per_pixel,
+  const void *src,
+  u8 src_bits_per_pixel,
+  sg_area_t area,
+  const sg_color_t *color_map);
 static inline void sg_bmap_copy(sg_bmap_t *dest, const sg_bmap_t *src) {
   memcpy(dest, src, sizeof(sg_bmap_t));
 }
@@ -578,6 +634,80 @@ void sg_draw_sub_bitmap(
   const sg_bmap_t *bmap_src,
   const sg_region_t *region_src);
 
+/*! \details Draws a run-length encoded bitmap on the bitmap.
+ *
+ * @param bmap_dest The destination bitmap
+ * @param p_dest The point in the destination bitmap of the top left corner
+ * @param bmap_src The run-length encoded source bitmap
+ */
+void sg_draw_rle_bitmap(
+  const sg_bmap_t *bmap_dest,
+  sg_point_t p_dest,
+  const sg_rle_bmap_t *bmap_src);
+
+/*! \details Draws a subset of a run-length encoded bitmap
+ * on the destination bitmap.
+ *
+ * @param bmap_dest The destination bitmap
+ * @param p_dest The point in the destination bitmap to start setting pixels
+ * @param bmap_src The run-length encoded source bitmap
+ * @param region_src The region of the source bitmap to draw
+ *
+ * Only the rows and columns within the visible region are decoded. Solid
+ * runs are drawn as patterns using 32-bit word operations.
+ *
+ */
+void sg_draw_sub_rle_bitmap(
+  const sg_bmap_t *bmap_dest,
+  sg_point_t p_dest,
+  const sg_rle_bmap_t *bmap_src,
+  const sg_region_t *region_src);
+
+/*! \details Draws a list of glyphs that are on the same canvas.
+ *
+ * @param bmap_dest The destination bitmap
+ * @param canvas The canvas that has the glyphs
+ * @param glyph_list The glyphs to draw
+ * @param count The number of glyphs in \a glyph_list
+ *
+ * This draws the same pixels as calling sg_draw_sub_bitmap() for
+ * each glyph. When the canvas is 1bpp and the pen is zero transparent
+ * and solid, only the set bits of the canvas are visited. Clipping
+ * is skipped if every glyph is inside both bitmaps.
+ *
+ */
+void sg_draw_glyph_run(
+  const sg_bmap_t *bmap_dest,
+  const sg_bmap_t *canvas,
+  const sg_glyph_t *glyph_list,
+  u32 count);
+
+/*! \details Draws a list of anti-aliased glyphs that are on the same
+ * canvas.
+ *
+ * @param bmap_dest The destination bitmap
+ * @param canvas The canvas with the glyph coverage values
+ * @param glyph_list The glyphs to draw
+ * @param count The number of glyphs in \a glyph_list
+ * @param blend_table Maps destination colors and coverage to colors
+ *
+ * Each pixel with a non-zero coverage value is replaced with the
+ * blend table entry for the existing pixel and the coverage value.
+ * The pen is not used. Destination pixels beyond the blend table
+ * color count are left unchanged.
+ *
+ * If the canvas does not match the blend table or the destination
+ * uses more than 8 bits per pixel, this is the same as
+ * sg_draw_glyph_run().
+ *
+ */
+void sg_draw_blended_glyph_run(
+  const sg_bmap_t *bmap_dest,
+  const sg_bmap_t *canvas,
+  const sg_glyph_t *glyph_list,
+  u32 count,
+  const sg_blend_table_t *blend_table);
+
 /*! @} */
 
 /*! \addtogroup BMAPVECTOR Vector Graphics
@@ -770,6 +900,45 @@ typedef struct MCU_PACK {
     const sg_antialias_filter_t *filter,
     sg_region_t region);
 
+  void (*draw_rle_bitmap)(
+    const sg_bmap_t *bmap_dest,
+    sg_point_t p_dest,
+    const sg_rle_bmap_t *bmap_src);
+  void (*draw_sub_rle_bitmap)(
+    const sg_bmap_t *bmap_dest,
+    sg_point_t p_dest,
+    const sg_rle_bmap_t *bmap_src,
+    const sg_region_t *region_src);
+
+  void (*convert_bmap_data)(
+    sg_bmap_data_t *dest,
+    u8 dest_bits_per_pixel,
+    const void *src,
+    u8 src_bits_per_pixel,
+    sg_area_t area,
+    const sg_color_t *color_map);
+
+  u64 (*calc_bmap_hash)(const sg_bmap_t *bmap, const sg_region_t *region);
+  u32 (*calc_bmap_row_diff)(
+    const sg_bmap_t *a,
+    const sg_bmap_t *b,
+    sg_int_t y,
+    sg_int_t *x_first,
+    sg_int_t *x_last);
+
+  void (*draw_glyph_run)(
+    const sg_bmap_t *bmap_dest,
+    const sg_bmap_t *canvas,
+    const sg_glyph_t *glyph_list,
+    u32 count);
+
+  void (*draw_blended_glyph_run)(
+    const sg_bmap_t *bmap_dest,
+    const sg_bmap_t *canvas,
+    const sg_glyph_t *glyph_list,
+    u32 count,
+    const sg_blend_table_t *blend_table);
+
 } sg_api_t;
 
 extern const sg_api_t sg_api;
@@ -77,6 +77,51 @@ typedef struct MCU_PACK {
   s8 offset_y /*! Character's y offset */;
 } sg_font_char_t;
 
+/*! \details This flag is set in sg_font_header_t::version when
+ * the font has a sparse unicode index. A unicode font looks like this
+ * in memory (or a file):
+ *
+ * sg_font_header_t hdr;
+ * sg_font_unicode_header_t unicode_hdr;
+ * sg_font_unicode_range_t range0;
+ * sg_font_unicode_range_t range1;
+ * ...
+ * sg_font_kerning_pair_t kerning0;
+ * ...
+ * sg_font_char_t char0;
+ * ...
+ * canvases (starting at hdr.size)
+ *
+ * The ranges are sorted by the first code point and the characters
+ * are stored in range order.
+ */
+#define SG_FONT_VERSION_FLAG_IS_UNICODE 0x8000
+
+/*! \details Set in sg_font_header_t::version when the 2bpp or 4bpp
+ * canvases hold glyph coverage (0 is the background and the largest
+ * value is fully covered) so the font can be drawn anti-aliased
+ * using a blend table (see sg_draw_blended_glyph_run()).
+ */
+#define SG_FONT_VERSION_FLAG_IS_COVERAGE 0x4000
+
+/*! \brief Unicode Font Header
+ * \details Follows sg_font_header_t in fonts that have
+ * SG_FONT_VERSION_FLAG_IS_UNICODE set.
+ */
+typedef struct MCU_PACK {
+  u32 character_count /*! Number of characters in the font */;
+  u32 range_count /*! Number of code point ranges */;
+} sg_font_unicode_header_t;
+
+/*! \brief Unicode Font Range
+ * \details Maps consecutive code points to character records.
+ */
+typedef struct MCU_PACK {
+  u32 first /*! First code point in the range */;
+  u32 count /*! Number of code points in the range */;
+  u32 character_offset /*! Offset of the first character in the range */;
+} sg_font_unicode_range_t;
+
 typedef struct MCU_PACK {
   u16 unicode_first;
   u16 unicode_second;
@@ -25,8 +25,8 @@ typedef int64_t s64;
 
 #include <sys/types.h>
 
-#define SG_STR_VERSION "3.1"
-#define SG_VERSION 0x0301
+#define SG_STR_VERSION "3.2"
+#define SG_VERSION 0x0302
 
 #define SG_MAX (32767)
 #define SG_MIN (-32767)
@@ -168,6 +168,49 @@ typedef struct CMSDK_PACK {
   // this must be 4 byte aligned
 } sg_bmap_header_t;
 
+#define SG_RLE_BMAP_SIGNATURE 0x454c5253 /*! SRLE */
+#define SG_RLE_RUN_FLAG_IS_LITERAL (1 << 15)
+#define SG_RLE_RUN_COUNT_MASK (0x7fff)
+
+/*! \brief Run-length Encoded Bitmap Header
+ * \details Header for a run-length encoded bitmap file.
+ *
+ * File:
+ * 0: sg_rle_bmap_header_t
+ * X: u32 row_offsets[height] (byte offset of each row's first run)
+ * Y: sg_rle_run_t runs
+ *
+ * Each row is a series of runs whose counts add up to the width. A
+ * literal run (SG_RLE_RUN_FLAG_IS_LITERAL) is followed by the packed
+ * pixels of the run padded to a 32-bit word.
+ *
+ */
+typedef struct CMSDK_PACK {
+  sg_size_t width;
+  sg_size_t height;
+  u32 size /*! Number of bytes following the header */;
+  sg_size_t bits_per_pixel;
+  u16 version;
+  u32 signature /*! Must be SG_RLE_BMAP_SIGNATURE */;
+  // this must be 4 byte aligned
+} sg_rle_bmap_header_t;
+
+typedef struct CMSDK_PACK {
+  u16 count /*! Number of pixels in the run (SG_RLE_RUN_COUNT_MASK) */;
+  u16 color /*! Color of the pixels (zero for literal runs) */;
+} sg_rle_run_t;
+
+/*! \brief Run-length Encoded Bitmap
+ * \details Describes a run-length encoded bitmap in memory. The
+ * runs can be drawn on a sg_bmap_t without being decoded first.
+ */
+typedef struct CMSDK_PACK {
+  sg_area_t area /*! The bitmap's dimensions */;
+  u8 bits_per_pixel /*! The number of bits in each pixel */;
+  const u32 *row_offsets /*! Byte offset of each row relative to \a runs */;
+  const sg_bmap_data_t *runs /*! Runs and literal data */;
+} sg_rle_bmap_t;
+
 /*! \brief Graphics Region Structure
  * \details Describes an area using a point and a dimension */
 typedef struct CMSDK_PACK {
@@ -175,6 +218,30 @@ typedef struct CMSDK_PACK {
   sg_area_t area /*! Area of the region */;
 } sg_region_t;
 
+/*! \brief Glyph Structure
+ * \details Describes where a glyph is on a font canvas and
+ * where it is drawn.
+ */
+typedef struct CMSDK_PACK {
+  sg_point_t point /*! Where the top left corner of the glyph is drawn */;
+  sg_region_t region /*! The glyph's region on the canvas */;
+} sg_glyph_t;
+
+/*! \brief Blend Table Structure
+ * \details Maps a destination color and a glyph coverage value
+ * to the color that is drawn. The colors are palette indices so
+ * anti-aliased glyphs can be drawn without any color math.
+ *
+ * The result for \a background and \a coverage is
+ * `color_map[background * (1 << coverage_bits_per_pixel) + coverage]`.
+ */
+typedef struct CMSDK_PACK {
+  u8 coverage_bits_per_pixel /*! Bits per pixel of the coverage canvas */;
+  u8 resd;
+  u16 color_count /*! Number of destination colors in the table */;
+  const u8 *color_map /*! Resulting colors (color_count rows) */;
+} sg_blend_table_t;
+
 enum {
   SG_VECTOR_PATH_FLAG_CLOSE_PATH = (1 << 0),
   SG_VECTOR_PATH_FLAG_IS_FILL_ODD_EVEN = (1 << 1),
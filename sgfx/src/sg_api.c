@@ -76,6 +76,19 @@ const sg_api_t sg_api = {
   .animate_init = sg_animate_init,
 
   .antialias_filter_init = sg_antialias_filter_init,
-  .antialias_filter_apply = sg_antialias_filter_apply
+  .antialias_filter_apply = sg_antialias_filter_apply,
+
+  // run-length encoded bitmaps
+  .draw_rle_bitmap = sg_draw_rle_bitmap,
+  .draw_sub_rle_bitmap = sg_draw_sub_rle_bitmap,
+
+  // bitmap data
+  .convert_bmap_data = sg_convert_bmap_data,
+  .calc_bmap_hash = sg_calc_bmap_hash,
+  .calc_bmap_row_diff = sg_calc_bmap_row_diff,
+
+  // text
+  .draw_glyph_run = sg_draw_glyph_run,
+  .draw_blended_glyph_run = sg_draw_blended_glyph_run
 
 };
@@ -0,0 +1,85 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include "sg_config.h"
+#include "sgfx.h"
+
+static u32 count_bits(u32 value);
+static int find_lowest_bit(u32 value);
+static int find_highest_bit(u32 value);
+
+u32 sg_calc_bmap_row_diff(
+  const sg_bmap_t *a,
+  const sg_bmap_t *b,
+  sg_int_t y,
+  sg_int_t *x_first,
+  sg_int_t *x_last) {
+  const u8 bits_per_pixel = SG_BITS_PER_PIXEL_VALUE(a);
+  const u32 pixels_per_word = SG_BITS_PER_WORD / bits_per_pixel;
+  const u32 bit_count = a->area.width * bits_per_pixel;
+  const u32 words = sg_calc_word_width(bit_count);
+  // the lowest bit of each pixel (e.g. 0x55555555 for 2bpp)
+  const u32 pixel_mask = bits_per_pixel == SG_BITS_PER_WORD
+                           ? 1
+                           : 0xffffffff / ((1UL << bits_per_pixel) - 1);
+  const sg_bmap_data_t *row_a = a->data + y * a->columns;
+  const sg_bmap_data_t *row_b = b->data + y * b->columns;
+  u32 count = 0;
+  u32 i;
+  u32 shift;
+
+  *x_first = -1;
+  *x_last = -1;
+
+  for (i = 0; i < words; i++) {
+    sg_bmap_data_t difference = row_a[i] ^ row_b[i];
+    if (difference == 0) {
+      continue;
+    }
+
+    if ((i == words - 1) && (bit_count % SG_BITS_PER_WORD)) {
+      // ignore the padding at the end of the row
+      difference &= (1UL << (bit_count % SG_BITS_PER_WORD)) - 1;
+    }
+
+    // reduce each changed pixel to a single bit
+    for (shift = 1; shift < bits_per_pixel; shift <<= 1) {
+      difference |= difference >> shift;
+    }
+    difference &= pixel_mask;
+
+    if (difference) {
+      const sg_int_t x = i * pixels_per_word;
+      if (*x_first < 0) {
+        *x_first = x + find_lowest_bit(difference) / bits_per_pixel;
+      }
+      *x_last = x + find_highest_bit(difference) / bits_per_pixel;
+      count += count_bits(difference);
+    }
+  }
+
+  return count;
+}
+
+u32 count_bits(u32 value) {
+  value = value - ((value >> 1) & 0x55555555);
+  value = (value & 0x33333333) + ((value >> 2) & 0x33333333);
+  value = (value + (value >> 4)) & 0x0f0f0f0f;
+  return (value * 0x01010101) >> 24;
+}
+
+int find_lowest_bit(u32 value) {
+  int result = 0;
+  while ((value & 0x01) == 0) {
+    value >>= 1;
+    result++;
+  }
+  return result;
+}
+
+int find_highest_bit(u32 value) {
+  int result = 0;
+  while (value >>= 1) {
+    result++;
+  }
+  return result;
+}
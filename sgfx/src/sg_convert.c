@@ -0,0 +1,82 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include "sg_config.h"
+#include "sgfx.h"
+
+static sg_color_t calc_mask(u8 bits_per_pixel);
+
+void sg_convert_bmap_data(
+  sg_bmap_data_t *dest,
+  u8 dest_bits_per_pixel,
+  const void *src,
+  u8 src_bits_per_pixel,
+  sg_area_t area,
+  const sg_color_t *color_map) {
+  const u32 src_row_size
+    = sg_calc_word_width(area.width * src_bits_per_pixel)
+      * sizeof(sg_bmap_data_t);
+  const u32 dest_columns = sg_calc_word_width(area.width * dest_bits_per_pixel);
+  const sg_color_t src_mask = calc_mask(src_bits_per_pixel);
+  const sg_color_t dest_mask = calc_mask(dest_bits_per_pixel);
+  const u8 *src_row = src;
+  sg_bmap_data_t *dest_row = dest;
+  sg_size_t x;
+  sg_size_t y;
+
+  if ((src_bits_per_pixel == dest_bits_per_pixel) && (color_map == 0)) {
+    // nothing to convert
+    memcpy(dest, src, src_row_size * area.height);
+    return;
+  }
+
+  for (y = 0; y < area.height; y++) {
+    const u8 *src_word_pointer = src_row;
+    sg_bmap_data_t *dest_word_pointer = dest_row;
+    sg_bmap_data_t src_word = 0;
+    sg_bmap_data_t dest_word = 0;
+    u32 src_shift = SG_BITS_PER_WORD;
+    u32 dest_shift = 0;
+
+    // pixels are unpacked and packed one word at a time
+    for (x = 0; x < area.width; x++) {
+      sg_color_t color;
+      if (src_shift == SG_BITS_PER_WORD) {
+        memcpy(&src_word, src_word_pointer, sizeof(src_word));
+        src_word_pointer += sizeof(src_word);
+        src_shift = 0;
+      }
+
+      color = (src_word >> src_shift) & src_mask;
+      src_shift += src_bits_per_pixel;
+
+      if (color_map) {
+        color = color_map[color];
+      } else if (src_bits_per_pixel > dest_bits_per_pixel) {
+        // take only the most significant bits
+        color >>= (src_bits_per_pixel - dest_bits_per_pixel);
+      }
+
+      dest_word |= (color & dest_mask) << dest_shift;
+      dest_shift += dest_bits_per_pixel;
+      if (dest_shift == SG_BITS_PER_WORD) {
+        *dest_word_pointer++ = dest_word;
+        dest_word = 0;
+        dest_shift = 0;
+      }
+    }
+
+    if (dest_shift) {
+      *dest_word_pointer = dest_word;
+    }
+
+    src_row += src_row_size;
+    dest_row += dest_columns;
+  }
+}
+
+sg_color_t calc_mask(u8 bits_per_pixel) {
+  if (bits_per_pixel >= SG_BITS_PER_WORD) {
+    return 0xffffffff;
+  }
+  return (1UL << bits_per_pixel) - 1;
+}
@@ -0,0 +1,288 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include "sg_config.h"
+#include "sgfx.h"
+
+static int is_run_visible(
+  const sg_bmap_t *bmap_dest,
+  const sg_bmap_t *canvas,
+  const sg_glyph_t *glyph_list,
+  u32 count);
+static int clip_glyph(
+  const sg_bmap_t *bmap_dest,
+  const sg_bmap_t *canvas,
+  sg_glyph_t *glyph);
+static void draw_glyph(
+  const sg_bmap_t *bmap_dest,
+  const sg_bmap_t *canvas,
+  const sg_glyph_t *glyph,
+  sg_color_t color);
+static void draw_blended_glyph(
+  const sg_bmap_t *bmap_dest,
+  const sg_bmap_t *canvas,
+  const sg_glyph_t *glyph,
+  const sg_blend_table_t *blend_table);
+
+void sg_draw_glyph_run(
+  const sg_bmap_t *bmap_dest,
+  const sg_bmap_t *canvas,
+  const sg_glyph_t *glyph_list,
+  u32 count) {
+  const u16 o_flags = bmap_dest->pen.o_flags;
+  u32 i;
+
+  if (
+    (canvas->bits_per_pixel != 1)
+    || ((o_flags & SG_PEN_FLAG_IS_ZERO_TRANSPARENT) == 0)
+    || (o_flags & SG_PEN_FLAG_NOT_SOLID_MASK)) {
+    // other canvases and pens use the general bitmap path
+    for (i = 0; i < count; i++) {
+      sg_draw_sub_bitmap(
+        bmap_dest,
+        glyph_list[i].point,
+        canvas,
+        &glyph_list[i].region);
+    }
+    return;
+  }
+
+  // a 1bpp canvas has a single color (see copy_pixel() in sg_cursor.c)
+  const sg_color_t color
+    = SG_BITS_PER_PIXEL_VALUE(bmap_dest) == 1 ? 1 : bmap_dest->pen.color;
+
+  // clip once for the whole run
+  if (is_run_visible(bmap_dest, canvas, glyph_list, count)) {
+    for (i = 0; i < count; i++) {
+      draw_glyph(bmap_dest, canvas, glyph_list + i, color);
+    }
+    return;
+  }
+
+  for (i = 0; i < count; i++) {
+    sg_glyph_t glyph = glyph_list[i];
+    if (clip_glyph(bmap_dest, canvas, &glyph)) {
+      draw_glyph(bmap_dest, canvas, &glyph, color);
+    }
+  }
+}
+
+void sg_draw_blended_glyph_run(
+  const sg_bmap_t *bmap_dest,
+  const sg_bmap_t *canvas,
+  const sg_glyph_t *glyph_list,
+  u32 count,
+  const sg_blend_table_t *blend_table) {
+  u32 i;
+
+  if (
+    (blend_table == 0) || (blend_table->color_map == 0)
+    || (canvas->bits_per_pixel != blend_table->coverage_bits_per_pixel)
+    || (SG_BITS_PER_PIXEL_VALUE(bmap_dest) > 8)) {
+    sg_draw_glyph_run(bmap_dest, canvas, glyph_list, count);
+    return;
+  }
+
+  if (is_run_visible(bmap_dest, canvas, glyph_list, count)) {
+    for (i = 0; i < count; i++) {
+      draw_blended_glyph(bmap_dest, canvas, glyph_list + i, blend_table);
+    }
+    return;
+  }
+
+  for (i = 0; i < count; i++) {
+    sg_glyph_t glyph = glyph_list[i];
+    if (clip_glyph(bmap_dest, canvas, &glyph)) {
+      draw_blended_glyph(bmap_dest, canvas, &glyph, blend_table);
+    }
+  }
+}
+
+int is_run_visible(
+  const sg_bmap_t *bmap_dest,
+  const sg_bmap_t *canvas,
+  const sg_glyph_t *glyph_list,
+  u32 count) {
+  u32 i;
+  for (i = 0; i < count; i++) {
+    const sg_glyph_t *glyph = glyph_list + i;
+    const sg_int_t width = glyph->region.area.width;
+    const sg_int_t height = glyph->region.area.height;
+    if (
+      (glyph->point.x < 0) || (glyph->point.y < 0)
+      || (glyph->point.x + width > bmap_dest->area.width)
+      || (glyph->point.y + height > bmap_dest->area.height)
+      || (glyph->region.point.x < 0) || (glyph->region.point.y < 0)
+      || (glyph->region.point.x + width > canvas->area.width)
+      || (glyph->region.point.y + height > canvas->area.height)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+int clip_glyph(
+  const sg_bmap_t *bmap_dest,
+  const sg_bmap_t *canvas,
+  sg_glyph_t *glyph) {
+  sg_int_t x = glyph->point.x;
+  sg_int_t y = glyph->point.y;
+  sg_int_t canvas_x = glyph->region.point.x;
+  sg_int_t canvas_y = glyph->region.point.y;
+  sg_int_t width = glyph->region.area.width;
+  sg_int_t height = glyph->region.area.height;
+  sg_int_t delta;
+
+  // clip to the top left of both bitmaps
+  delta = x < canvas_x ? x : canvas_x;
+  if (delta < 0) {
+    x -= delta;
+    canvas_x -= delta;
+    width += delta;
+  }
+  delta = y < canvas_y ? y : canvas_y;
+  if (delta < 0) {
+    y -= delta;
+    canvas_y -= delta;
+    height += delta;
+  }
+
+  // clip to the bottom right of both bitmaps
+  if (x + width > bmap_dest->area.width) {
+    width = bmap_dest->area.width - x;
+  }
+  if (canvas_x + width > canvas->area.width) {
+    width = canvas->area.width - canvas_x;
+  }
+  if (y + height > bmap_dest->area.height) {
+    height = bmap_dest->area.height - y;
+  }
+  if (canvas_y + height > canvas->area.height) {
+    height = canvas->area.height - canvas_y;
+  }
+
+  if ((width <= 0) || (height <= 0)) {
+    return 0;
+  }
+
+  glyph->point.x = x;
+  glyph->point.y = y;
+  glyph->region.point.x = canvas_x;
+  glyph->region.point.y = canvas_y;
+  glyph->region.area.width = width;
+  glyph->region.area.height = height;
+  return 1;
+}
+
+void draw_glyph(
+  const sg_bmap_t *bmap_dest,
+  const sg_bmap_t *canvas,
+  const sg_glyph_t *glyph,
+  sg_color_t color) {
+  const u8 bits_per_pixel = SG_BITS_PER_PIXEL_VALUE(bmap_dest);
+  const sg_bmap_data_t pixel_mask
+    = bits_per_pixel == SG_BITS_PER_WORD ? 0xffffffff
+                                         : (1UL << bits_per_pixel) - 1;
+  const sg_bmap_data_t pixel_color = color & pixel_mask;
+  const sg_int_t width = glyph->region.area.width;
+  const sg_int_t height = glyph->region.area.height;
+  sg_int_t row;
+
+  if (pixel_color == 0) {
+    // the pen is zero transparent
+    return;
+  }
+
+  for (row = 0; row < height; row++) {
+    const sg_bmap_data_t *canvas_row
+      = canvas->data + (glyph->region.point.y + row) * canvas->columns;
+    sg_bmap_data_t *dest_row
+      = bmap_dest->data + (glyph->point.y + row) * bmap_dest->columns;
+    sg_int_t column = 0;
+
+    while (column < width) {
+      const u32 canvas_x = glyph->region.point.x + column;
+      const u32 shift = canvas_x % SG_BITS_PER_WORD;
+      sg_int_t span = SG_BITS_PER_WORD - shift;
+      sg_bmap_data_t bits = canvas_row[canvas_x / SG_BITS_PER_WORD] >> shift;
+
+      if (span > width - column) {
+        span = width - column;
+        bits &= (1UL << span) - 1;
+      }
+
+      // only the set bits (the visible pixels) are drawn
+      while (bits) {
+        const u32 x = glyph->point.x + column + __builtin_ctz(bits);
+        const u32 bit_offset = x * bits_per_pixel;
+        sg_bmap_data_t *target = dest_row + bit_offset / SG_BITS_PER_WORD;
+        const u32 target_shift = bit_offset % SG_BITS_PER_WORD;
+        *target = (*target & ~(pixel_mask << target_shift))
+                  | (pixel_color << target_shift);
+        bits &= bits - 1;
+      }
+
+      column += span;
+    }
+  }
+}
+
+void draw_blended_glyph(
+  const sg_bmap_t *bmap_dest,
+  const sg_bmap_t *canvas,
+  const sg_glyph_t *glyph,
+  const sg_blend_table_t *blend_table) {
+  const u8 bits_per_pixel = SG_BITS_PER_PIXEL_VALUE(bmap_dest);
+  const sg_bmap_data_t pixel_mask = (1UL << bits_per_pixel) - 1;
+  const u8 coverage_bits_per_pixel = canvas->bits_per_pixel;
+  const sg_bmap_data_t coverage_mask = (1UL << coverage_bits_per_pixel) - 1;
+  const u32 coverage_pixels_per_word
+    = SG_BITS_PER_WORD / coverage_bits_per_pixel;
+  const sg_int_t width = glyph->region.area.width;
+  const sg_int_t height = glyph->region.area.height;
+  sg_int_t row;
+
+  for (row = 0; row < height; row++) {
+    const sg_bmap_data_t *canvas_row
+      = canvas->data + (glyph->region.point.y + row) * canvas->columns;
+    sg_bmap_data_t *dest_row
+      = bmap_dest->data + (glyph->point.y + row) * bmap_dest->columns;
+    sg_int_t column = 0;
+
+    while (column < width) {
+      const u32 canvas_x = glyph->region.point.x + column;
+      const u32 canvas_pixel = canvas_x % coverage_pixels_per_word;
+      sg_int_t span = coverage_pixels_per_word - canvas_pixel;
+      sg_bmap_data_t coverage_bits
+        = canvas_row[canvas_x / coverage_pixels_per_word]
+          >> (canvas_pixel * coverage_bits_per_pixel);
+      sg_int_t pixel = 0;
+
+      if (span > width - column) {
+        span = width - column;
+      }
+
+      // uncovered words are skipped without touching the destination
+      while (coverage_bits && (pixel < span)) {
+        const u32 coverage = coverage_bits & coverage_mask;
+        if (coverage) {
+          const u32 bit_offset
+            = (glyph->point.x + column + pixel) * bits_per_pixel;
+          sg_bmap_data_t *target = dest_row + bit_offset / SG_BITS_PER_WORD;
+          const u32 target_shift = bit_offset % SG_BITS_PER_WORD;
+          const u32 background = (*target >> target_shift) & pixel_mask;
+          if (background < blend_table->color_count) {
+            const sg_bmap_data_t color
+              = blend_table->color_map
+                  [(background << coverage_bits_per_pixel) + coverage];
+            *target = (*target & ~(pixel_mask << target_shift))
+                      | ((color & pixel_mask) << target_shift);
+          }
+        }
+        coverage_bits >>= coverage_bits_per_pixel;
+        pixel++;
+      }
+
+      column += span;
+    }
+  }
+}
@@ -0,0 +1,111 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include "sg_config.h"
+#include "sgfx.h"
+
+#define PRIME64_1 0x9E3779B185EBCA87ULL
+#define PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define PRIME64_3 0x165667B19E3779F9ULL
+#define PRIME64_4 0x85EBCA77C2B2AE63ULL
+
+static u64 rotate_left(u64 value, u32 amount);
+static u64 hash_round(u64 accumulator, u64 input);
+static u64 hash_merge(u64 hash, u64 lane);
+
+u64 sg_calc_bmap_hash(const sg_bmap_t *bmap, const sg_region_t *region) {
+  int x = region->point.x;
+  int y = region->point.y;
+  int w = region->area.width;
+  int h = region->area.height;
+  const u8 bits_per_pixel = SG_BITS_PER_PIXEL_VALUE(bmap);
+  u64 lanes[4];
+  u64 hash;
+  u32 count = 0;
+  int i;
+
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (x + w > bmap->area.width) {
+    w = bmap->area.width - x;
+  }
+  if (y + h > bmap->area.height) {
+    h = bmap->area.height - y;
+  }
+  if ((w <= 0) || (h <= 0)) {
+    w = 0;
+    h = 0;
+  }
+
+  // the size of the region is part of the seed
+  hash = ((u64)w << 16) | (u64)h;
+  lanes[0] = hash + PRIME64_1 + PRIME64_2;
+  lanes[1] = hash + PRIME64_2;
+  lanes[2] = hash;
+  lanes[3] = hash - PRIME64_1;
+
+  for (i = 0; i < h; i++) {
+    const u32 bit_start = x * bits_per_pixel;
+    const u32 bit_count = w * bits_per_pixel;
+    const u32 shift = bit_start % SG_BITS_PER_WORD;
+    const u32 words = sg_calc_word_width(bit_count);
+    const u32 last = (bit_start + bit_count - 1) / SG_BITS_PER_WORD;
+    const sg_bmap_data_t *row
+      = bmap->data + (y + i) * bmap->columns + bit_start / SG_BITS_PER_WORD;
+    const sg_bmap_data_t last_mask
+      = (bit_count % SG_BITS_PER_WORD)
+          ? (sg_bmap_data_t)((1UL << (bit_count % SG_BITS_PER_WORD)) - 1)
+          : 0xffffffff;
+    u32 j;
+
+    // the row is realigned so the result does not depend on where
+    // the region starts within a word
+    for (j = 0; j < words; j++) {
+      sg_bmap_data_t word = row[j] >> shift;
+      if (shift && (bit_start / SG_BITS_PER_WORD + j < last)) {
+        word |= row[j + 1] << (SG_BITS_PER_WORD - shift);
+      }
+      if (j == words - 1) {
+        word &= last_mask;
+      }
+      lanes[count & 0x03] = hash_round(lanes[count & 0x03], word);
+      count++;
+    }
+  }
+
+  hash = rotate_left(lanes[0], 1) + rotate_left(lanes[1], 7)
+         + rotate_left(lanes[2], 12) + rotate_left(lanes[3], 18);
+  for (i = 0; i < 4; i++) {
+    hash = hash_merge(hash, lanes[i]);
+  }
+
+  hash += (u64)count * sizeof(sg_bmap_data_t);
+
+  // avalanche
+  hash ^= hash >> 33;
+  hash *= PRIME64_2;
+  hash ^= hash >> 29;
+  hash *= PRIME64_3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+u64 rotate_left(u64 value, u32 amount) {
+  return (value << amount) | (value >> (64 - amount));
+}
+
+u64 hash_round(u64 accumulator, u64 input) {
+  accumulator += input * PRIME64_2;
+  accumulator = rotate_left(accumulator, 31);
+  return accumulator * PRIME64_1;
+}
+
+u64 hash_merge(u64 hash, u64 lane) {
+  hash ^= hash_round(0, lane);
+  return hash * PRIME64_1 + PRIME64_4;
+}
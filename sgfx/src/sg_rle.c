@@ -0,0 +1,249 @@
+// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
+
+#include "sg_config.h"
+#include "sgfx.h"
+
+static void draw_row(
+  const sg_bmap_t *bmap_dest,
+  sg_point_t p_dest,
+  const sg_rle_bmap_t *bmap_src,
+  const sg_bmap_data_t *run_data,
+  int start,
+  int end);
+static void
+draw_solid(sg_cursor_t *cursor, u8 bits_per_pixel, sg_color_t color, int width);
+static void draw_literal(
+  sg_cursor_t *cursor,
+  u8 bits_per_pixel,
+  const sg_bmap_data_t *literal,
+  int offset,
+  int width);
+static sg_color_t
+map_color(const sg_bmap_t *bmap_dest, u8 bits_per_pixel, sg_color_t color);
+static sg_bmap_data_t create_pattern(const sg_bmap_t *bmap, sg_color_t color);
+
+void sg_draw_rle_bitmap(
+  const sg_bmap_t *bmap_dest,
+  sg_point_t p_dest,
+  const sg_rle_bmap_t *bmap_src) {
+  sg_region_t region;
+  region.point.point = 0;
+  region.area = bmap_src->area;
+  sg_draw_sub_rle_bitmap(bmap_dest, p_dest, bmap_src, &region);
+}
+
+void sg_draw_sub_rle_bitmap(
+  const sg_bmap_t *bmap_dest,
+  sg_point_t p_dest,
+  const sg_rle_bmap_t *bmap_src,
+  const sg_region_t *region_src) {
+  int x = region_src->point.x;
+  int y = region_src->point.y;
+  int w = region_src->area.width;
+  int h = region_src->area.height;
+  int dest_x = p_dest.x;
+  int dest_y = p_dest.y;
+  int i;
+
+  // truncate the region to the source
+  if (x < 0) {
+    w += x;
+    dest_x -= x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    dest_y -= y;
+    y = 0;
+  }
+  if (x + w > bmap_src->area.width) {
+    w = bmap_src->area.width - x;
+  }
+  if (y + h > bmap_src->area.height) {
+    h = bmap_src->area.height - y;
+  }
+
+  // truncate the region to the destination
+  if (dest_x < 0) {
+    x -= dest_x;
+    w += dest_x;
+    dest_x = 0;
+  }
+  if (dest_y < 0) {
+    y -= dest_y;
+    h += dest_y;
+    dest_y = 0;
+  }
+  if (dest_x + w > bmap_dest->area.width) {
+    w = bmap_dest->area.width - dest_x;
+  }
+  if (dest_y + h > bmap_dest->area.height) {
+    h = bmap_dest->area.height - dest_y;
+  }
+
+  if ((w <= 0) || (h <= 0)) {
+    return;
+  }
+
+  // only the rows in the region are decoded
+  for (i = 0; i < h; i++) {
+    const sg_bmap_data_t *run_data
+      = (const sg_bmap_data_t *)((const u8 *)bmap_src->runs
+                                 + bmap_src->row_offsets[y + i]);
+    draw_row(
+      bmap_dest,
+      sg_point(dest_x, dest_y + i),
+      bmap_src,
+      run_data,
+      x,
+      x + w);
+  }
+}
+
+void draw_row(
+  const sg_bmap_t *bmap_dest,
+  sg_point_t p_dest,
+  const sg_rle_bmap_t *bmap_src,
+  const sg_bmap_data_t *run_data,
+  int start,
+  int end) {
+  sg_cursor_t cursor;
+  sg_rle_run_t run;
+  int x = 0;
+  int count;
+  int literal_words;
+  int span_start;
+  int span_end;
+
+  while (x < end) {
+    memcpy(&run, run_data, sizeof(run));
+    run_data++;
+
+    count = run.count & SG_RLE_RUN_COUNT_MASK;
+    if (count == 0) {
+      // malformed row
+      return;
+    }
+
+    literal_words = 0;
+    if (run.count & SG_RLE_RUN_FLAG_IS_LITERAL) {
+      literal_words = sg_calc_word_width(count * bmap_src->bits_per_pixel);
+    }
+
+    // runs to the left of the region are skipped without being decoded
+    span_start = x > start ? x : start;
+    span_end = (x + count) < end ? (x + count) : end;
+
+    if (span_start < span_end) {
+      sg_cursor_set(
+        &cursor,
+        bmap_dest,
+        sg_point(p_dest.x + span_start - start, p_dest.y));
+
+      if (literal_words) {
+        draw_literal(
+          &cursor,
+          bmap_src->bits_per_pixel,
+          run_data,
+          span_start - x,
+          span_end - span_start);
+      } else {
+        draw_solid(
+          &cursor,
+          bmap_src->bits_per_pixel,
+          run.color,
+          span_end - span_start);
+      }
+    }
+
+    run_data += literal_words;
+    x += count;
+  }
+}
+
+void draw_solid(
+  sg_cursor_t *cursor,
+  u8 bits_per_pixel,
+  sg_color_t color,
+  int width) {
+  color = map_color(cursor->bmap, bits_per_pixel, color);
+  if (
+    (color == 0)
+    && (cursor->bmap->pen.o_flags & SG_PEN_FLAG_IS_ZERO_TRANSPARENT)) {
+    return;
+  }
+
+  // the whole span is drawn using 32-bit word operations
+  sg_cursor_draw_pattern(cursor, width, create_pattern(cursor->bmap, color));
+}
+
+void draw_literal(
+  sg_cursor_t *cursor,
+  u8 bits_per_pixel,
+  const sg_bmap_data_t *literal,
+  int offset,
+  int width) {
+  const sg_bmap_t *bmap_dest = cursor->bmap;
+  int i;
+
+  if (bits_per_pixel == SG_BITS_PER_PIXEL_VALUE(bmap_dest)) {
+    // wrap the literal pixels in a single row bitmap and copy as words
+    sg_bmap_t literal_bmap;
+    sg_cursor_t literal_cursor;
+    memset(&literal_bmap, 0, sizeof(literal_bmap));
+    literal_bmap.data = (sg_bmap_data_t *)literal;
+    literal_bmap.area = sg_dim(offset + width, 1);
+    literal_bmap.bits_per_pixel = bits_per_pixel;
+    literal_bmap.columns
+      = sg_calc_word_width((offset + width) * bits_per_pixel);
+    sg_cursor_set(&literal_cursor, &literal_bmap, sg_point(offset, 0));
+    sg_cursor_draw_cursor(cursor, &literal_cursor, width);
+    return;
+  }
+
+  for (i = 0; i < width; i++) {
+    const u32 bit_offset = (offset + i) * bits_per_pixel;
+    const sg_color_t mask
+      = bits_per_pixel == 32 ? 0xffffffffUL : ((1UL << bits_per_pixel) - 1);
+    const sg_bmap_data_t word = literal[bit_offset / SG_BITS_PER_WORD];
+    const sg_color_t color = map_color(
+      bmap_dest,
+      bits_per_pixel,
+      (word >> (bit_offset % SG_BITS_PER_WORD)) & mask);
+
+    if (
+      (color == 0)
+      && (bmap_dest->pen.o_flags & SG_PEN_FLAG_IS_ZERO_TRANSPARENT)) {
+      sg_cursor_inc_x(cursor);
+    } else {
+      sg_cursor_draw_pattern(cursor, 1, create_pattern(bmap_dest, color));
+    }
+  }
+}
+
+sg_color_t
+map_color(const sg_bmap_t *bmap_dest, u8 bits_per_pixel, sg_color_t color) {
+  const u8 dest_bits_per_pixel = SG_BITS_PER_PIXEL_VALUE(bmap_dest);
+  // same mapping as copying pixels between bitmaps
+  if (bits_per_pixel > dest_bits_per_pixel) {
+    return color >> (bits_per_pixel - dest_bits_per_pixel);
+  }
+
+  if ((bits_per_pixel < dest_bits_per_pixel) && color) {
+    return color + bmap_dest->pen.color - 1;
+  }
+
+  return color;
+}
+
+sg_bmap_data_t create_pattern(const sg_bmap_t *bmap, sg_color_t color) {
+  sg_bmap_data_t pattern = 0;
+  sg_size_t i;
+  if (SG_BITS_PER_PIXEL_VALUE(bmap) == SG_BITS_PER_WORD) {
+    return color;
+  }
+  for (i = 0; i < SG_BITS_PER_WORD; i += SG_BITS_PER_PIXEL_VALUE(bmap)) {
+    pattern |= ((color & SG_PIXEL_MASK(bmap)) << i);
+  }
+  return pattern;
+}
@@ -1,6 +1,7 @@
 ﻿// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
 
 #include <cstdio>
+#include <cstring>
 
 #include "chrono.hpp"
 #include "fs.hpp"
@@ -12,6 +13,40 @@
 
 #include "test/Test.hpp"
 
+#include "ux/Assets.hpp"
+#include "ux/Controller.hpp"
+#include "ux/Display.hpp"
+#include "ux/EventLoop.hpp"
+#include "ux/FramebufferDisplayDevice.hpp"
+#include "ux/Model.hpp"
+#include "ux/SimulatedDisplayDevice.hpp"
+#include "ux/TextArea.hpp"
+#include "ux/TextBuffer.hpp"
+#include "ux/TextFileArea.hpp"
+#include "ux/VirtualList.hpp"
+#include "ux/draw/RichText.hpp"
+#include "ux/draw/Text.hpp"
+#include "ux/draw/TextBox.hpp"
+#include "ux/fmt/AssetPack.hpp"
+#include "ux/sgfx/BitmapConverter.hpp"
+#include "ux/sgfx/BitmapDiff.hpp"
+#include "ux/sgfx/CanvasCache.hpp"
+#include "ux/sgfx/Font.hpp"
+#include "ux/sgfx/IconFont.hpp"
+#include "ux/sgfx/RleBitmap.hpp"
+#include "ux/sgfx/TextRunCache.hpp"
+
+// counts calls to operator new (see main.cpp)
+class AllocationCounter {
+public:
+  static void increment() { m_count++; }
+  static void reset() { m_count = 0; }
+  static size_t count() { return m_count; }
+
+private:
+  static inline size_t m_count = 0;
+};
+
 class UnitTest : public test::Test {
 public:
 
@@ -19,10 +54,2031 @@ public:
 
   bool execute_class_api_case() {
 
- 
+    if (!mapped_bitmap_case()) {
+      return false;
+    }
+
+    if (!rle_bitmap_case()) {
+      return false;
+    }
+
+    if (!bitmap_converter_case()) {
+      return false;
+    }
+
+    if (!bitmap_hash_case()) {
+      return false;
+    }
+
+    if (!bitmap_diff_case()) {
+      return false;
+    }
+
+    if (!font_metrics_case()) {
+      return false;
+    }
+
+    if (!font_kerning_case()) {
+      return false;
+    }
+
+    if (!font_view_case()) {
+      return false;
+    }
+
+    if (!canvas_cache_case()) {
+      return false;
+    }
+
+    if (!text_run_cache_case()) {
+      return false;
+    }
+
+    if (!utf8_decode_case()) {
+      return false;
+    }
+
+    if (!font_unicode_case()) {
+      return false;
+    }
+
+    if (!glyph_run_case()) {
+      return false;
+    }
+
+    if (!blend_table_case()) {
+      return false;
+    }
+
+    if (!asset_pack_case()) {
+      return false;
+    }
+
+    if (!text_file_area_case()) {
+      return false;
+    }
+
+    if (!icon_font_case()) {
+      return false;
+    }
+
+    if (!rich_text_case()) {
+      return false;
+    }
+
+    if (!text_layout_case()) {
+      return false;
+    }
+
+    if (!virtual_list_case()) {
+      return false;
+    }
+
+    if (!text_buffer_case()) {
+      return false;
+    }
+
+    if (!text_area_case()) {
+      return false;
+    }
+
+    if (!display_device_case()) {
+      return false;
+    }
+
+    if (!compositor_case()) {
+      return false;
+    }
+
+    if (!display_state_case()) {
+      return false;
+    }
 
     return true;
   }
 
 private:
+  bool mapped_bitmap_case() {
+    using namespace ux;
+
+    sg_bmap_header_t header = {};
+    header.width = 8;
+    header.height = 2;
+    header.bits_per_pixel = 1;
+    header.version = sgfx::Bitmap::api()->sos_api.version;
+    header.size = sizeof(sg_bmap_data_t) * 2;
+
+    // a one byte prefix moves the pixels off the word boundary
+    var::Data data(sizeof(sg_bmap_data_t) + sizeof(header) + header.size);
+    for (const size_t offset : {size_t(0), size_t(1)}) {
+      var::View(data).fill<u8>(0);
+      memcpy(data.data_u8() + offset, &header, sizeof(header));
+      data.data_u8()[offset + sizeof(header)] = 0x81;
+
+      sgfx::MappedBitmap mapped(var::View(data).pop_front(offset));
+      TEST_ASSERT(mapped.is_valid());
+      TEST_ASSERT(mapped.area() == sgfx::Area(8, 2));
+      TEST_ASSERT(mapped.is_zero_copy() == (offset == 0));
+
+      const sgfx::Bitmap &bitmap = mapped.bitmap();
+      TEST_ASSERT(
+        (bitmap.bmap()->data == mapped.data().to_const_void())
+        == (offset == 0));
+      TEST_ASSERT(bitmap.get_pixel(sgfx::Point(0, 0)) != 0);
+      TEST_ASSERT(bitmap.get_pixel(sgfx::Point(1, 0)) == 0);
+      TEST_ASSERT(bitmap.get_pixel(sgfx::Point(7, 0)) != 0);
+      TEST_ASSERT(bitmap.get_pixel(sgfx::Point(0, 1)) == 0);
+    }
+
+    // a header from another version of sgfx is rejected
+    header.version++;
+    memcpy(data.data_u8(), &header, sizeof(header));
+    {
+      sgfx::MappedBitmap mapped((var::View(data)));
+      TEST_ASSERT(mapped.is_valid() == false);
+    }
+    api::ExecutionContext::reset_error();
+
+    return true;
+  }
+
+  bool rle_bitmap_case() {
+    using namespace ux;
+
+    // solid rows, a solid run between literals, and a dither pattern
+    sgfx::BitmapData bitmap(
+      sgfx::Area(100, 4),
+      sgfx::Bitmap::BitsPerPixel::x4);
+    bitmap.clear();
+    for (sg_int_t x = 0; x < 100; x++) {
+      bitmap.set_pen(sgfx::Pen().set_color(5)).draw_pixel(sgfx::Point(x, 1));
+      bitmap.set_pen(sgfx::Pen().set_color(x < 40 || x > 80 ? x % 16 : 9))
+        .draw_pixel(sgfx::Point(x, 2));
+      bitmap.set_pen(sgfx::Pen().set_color(x % 2 ? 15 : 1))
+        .draw_pixel(sgfx::Point(x, 3));
+    }
+
+    auto is_equal = [&](const sgfx::RleBitmap &rle_bitmap) {
+      sgfx::BitmapData decoded(bitmap.area(), bitmap.bits_per_pixel());
+      decoded.clear();
+      decoded.set_pen(sgfx::Pen()).draw_bitmap(sgfx::Point(), rle_bitmap);
+      for (sg_int_t y = 0; y < bitmap.height(); y++) {
+        for (sg_int_t x = 0; x < bitmap.width(); x++) {
+          const sgfx::Point point(x, y);
+          if (decoded.get_pixel(point) != bitmap.get_pixel(point)) {
+            return false;
+          }
+        }
+      }
+      return true;
+    };
+
+    sgfx::RleBitmapData encoded(bitmap);
+    TEST_ASSERT(encoded.is_valid());
+    TEST_ASSERT(encoded.area() == bitmap.area());
+    TEST_ASSERT(encoded.view().size() < bitmap.calculate_size());
+    TEST_ASSERT(is_equal(encoded));
+
+    // moving does not copy or re-validate the runs
+    const void *runs = encoded.rle_bmap()->runs;
+    sgfx::RleBitmapData moved(std::move(encoded));
+    TEST_ASSERT(encoded.is_valid() == false);
+    TEST_ASSERT(encoded.view().size() == 0);
+    TEST_ASSERT(moved.rle_bmap()->runs == runs);
+
+    fs::DataFile file;
+    moved.save(file);
+    file.seek(0);
+    sgfx::RleBitmapData loaded;
+    loaded.load(file);
+    TEST_ASSERT(loaded.is_valid());
+    TEST_ASSERT(loaded.view() == moved.view());
+    TEST_ASSERT(is_equal(loaded));
+
+    return true;
+  }
+
+  bool bitmap_converter_case() {
+    using namespace ux;
+
+    sgfx::BitmapData source(
+      sgfx::Area(16, 1),
+      sgfx::Bitmap::BitsPerPixel::x4);
+    for (sg_int_t x = 0; x < 16; x++) {
+      source.set_pen(sgfx::Pen().set_color(x)).draw_pixel(sgfx::Point(x, 0));
+    }
+
+    // fewer bits keep the most significant bits, more bits keep the value
+    const sgfx::BitmapData reduced
+      = sgfx::BitmapConverter().convert(source, sgfx::Bitmap::BitsPerPixel::x2);
+    const sgfx::BitmapData expanded
+      = sgfx::BitmapConverter().convert(source, sgfx::Bitmap::BitsPerPixel::x8);
+    TEST_ASSERT(reduced.bits_per_pixel() == sgfx::Bitmap::BitsPerPixel::x2);
+    for (sg_int_t x = 0; x < 16; x++) {
+      TEST_ASSERT(reduced.get_pixel(sgfx::Point(x, 0)) == sg_color_t(x >> 2));
+      TEST_ASSERT(expanded.get_pixel(sgfx::Point(x, 0)) == sg_color_t(x));
+    }
+
+    var::Vector<sg_color_t> color_map;
+    for (sg_color_t color = 0; color < 16; color++) {
+      color_map.push_back(15 - color);
+    }
+    const sgfx::BitmapData inverted
+      = sgfx::BitmapConverter().set_color_map(color_map).convert(
+        source,
+        sgfx::Bitmap::BitsPerPixel::x4);
+    for (sg_int_t x = 0; x < 16; x++) {
+      TEST_ASSERT(inverted.get_pixel(sgfx::Point(x, 0)) == sg_color_t(15 - x));
+    }
+
+    // black and white map to the nearest entries of a 2bpp palette
+    sgfx::Palette monochrome;
+    monochrome.set_pixel_format(sgfx::Palette::PixelFormat::rgb565)
+      .set_color_count(sgfx::Palette::ColorCount::x1bpp);
+    monochrome.colors().at(0) = 0x0000;
+    monochrome.colors().at(1) = 0xffff;
+    sgfx::Palette display;
+    display.set_pixel_format(sgfx::Palette::PixelFormat::rgb565)
+      .set_color_count(sgfx::Palette::ColorCount::x2bpp);
+    display.colors().at(0) = 0xf800;
+    display.colors().at(1) = 0xffff;
+    display.colors().at(2) = 0x07e0;
+    display.colors().at(3) = 0x0000;
+    sgfx::BitmapConverter converter;
+    converter.set_palette(monochrome, display);
+    TEST_ASSERT(converter.color_map().count() == 2);
+    TEST_ASSERT(converter.color_map().at(0) == 3);
+    TEST_ASSERT(converter.color_map().at(1) == 1);
+
+    return true;
+  }
+
+  bool bitmap_hash_case() {
+    using namespace ux;
+
+    sgfx::BitmapData bitmap(
+      sgfx::Area(96, 8),
+      sgfx::Bitmap::BitsPerPixel::x2);
+    bitmap.clear();
+
+    // the same pattern at offsets that straddle words differently
+    const sgfx::Area area(21, 5);
+    const sg_int_t offsets[] = {3, 40, 64};
+    for (const sg_int_t offset : offsets) {
+      for (sg_int_t y = 0; y < area.height(); y++) {
+        for (sg_int_t x = 0; x < area.width(); x++) {
+          bitmap.set_pen(sgfx::Pen().set_color((x * 7 + y) % 4))
+            .draw_pixel(sgfx::Point(offset + x, y + 1));
+        }
+      }
+    }
+
+    const u64 hash
+      = bitmap.calculate_hash(sgfx::Region(sgfx::Point(3, 1), area));
+    for (const sg_int_t offset : offsets) {
+      TEST_ASSERT(
+        bitmap.calculate_hash(sgfx::Region(sgfx::Point(offset, 1), area))
+        == hash);
+    }
+
+    // pixels outside the region do not change the hash
+    bitmap.set_pen(sgfx::Pen().set_color(3))
+      .draw_pixel(sgfx::Point(39, 1))
+      .draw_pixel(sgfx::Point(61, 1));
+    TEST_ASSERT(
+      bitmap.calculate_hash(sgfx::Region(sgfx::Point(40, 1), area)) == hash);
+
+    // one pixel inside the region does
+    const sgfx::Point point(50, 3);
+    bitmap.set_pen(sgfx::Pen().set_color(bitmap.get_pixel(point) ^ 1))
+      .draw_pixel(point);
+    TEST_ASSERT(
+      bitmap.calculate_hash(sgfx::Region(sgfx::Point(40, 1), area)) != hash);
+
+    return true;
+  }
+
+  bool bitmap_diff_case() {
+    using namespace ux;
+
+    sgfx::BitmapData previous(
+      sgfx::Area(64, 16),
+      sgfx::Bitmap::BitsPerPixel::x1);
+    previous.clear();
+    sgfx::BitmapData current(previous.area(), previous.bits_per_pixel());
+    current.clear();
+    TEST_ASSERT(sgfx::BitmapDiff(previous, current).is_changed() == false);
+
+    // a cluster near the top left and a distant pixel
+    current.set_pen(sgfx::Pen())
+      .draw_pixel(sgfx::Point(2, 1))
+      .draw_pixel(sgfx::Point(3, 2))
+      .draw_pixel(sgfx::Point(60, 14));
+
+    auto is_region
+      = [](const sgfx::Region &region, sgfx::Point point, sgfx::Area area) {
+          return (region.point() == point) && (region.area() == area);
+        };
+
+    {
+      const sgfx::BitmapDiff diff(previous, current);
+      TEST_ASSERT(diff.changed_pixel_count() == 3);
+      TEST_ASSERT(diff.changed_row_count() == 3);
+      TEST_ASSERT(diff.region_list().count() == 2);
+      TEST_ASSERT(is_region(
+        diff.region_list().at(0),
+        sgfx::Point(2, 1),
+        sgfx::Area(2, 2)));
+      TEST_ASSERT(is_region(
+        diff.region_list().at(1),
+        sgfx::Point(60, 14),
+        sgfx::Area(1, 1)));
+      TEST_ASSERT(diff.calculate_region_pixel_count() == 5);
+      TEST_ASSERT(is_region(
+        diff.calculate_bounds(),
+        sgfx::Point(2, 1),
+        sgfx::Area(59, 14)));
+    }
+
+    // a full list is merged regardless of the cost
+    {
+      const sgfx::BitmapDiff diff(
+        previous,
+        current,
+        sgfx::BitmapDiff::Options().set_maximum_region_count(1));
+      TEST_ASSERT(diff.region_list().count() == 1);
+      TEST_ASSERT(is_region(
+        diff.region_list().at(0),
+        sgfx::Point(2, 1),
+        sgfx::Area(59, 14)));
+      TEST_ASSERT(diff.calculate_region_pixel_count() == 59 * 14);
+    }
+
+    return true;
+  }
+
+  bool font_metrics_case() {
+    using namespace ux;
+
+    fs::DataFile file;
+    file.write(create_font_data()).seek(0);
+    sgfx::Font font(&file);
+    TEST_ASSERT(font.is_valid());
+    TEST_ASSERT(font.character_count() == '~' - ' ');
+
+    // the metrics are in memory so measuring does not use the file
+    const int location = file.location();
+    const sg_font_char_t *character = font.find_character('A');
+    TEST_ASSERT(character != nullptr);
+    TEST_ASSERT(character->id == 'A');
+    TEST_ASSERT(character->width == 4);
+    TEST_ASSERT(font.find_character('~') != nullptr);
+    TEST_ASSERT(font.find_character(0x7f) == nullptr);
+    TEST_ASSERT(font.get_advance('z') == 5);
+    TEST_ASSERT(font.get_advance(' ') == font.space_size());
+    TEST_ASSERT(font.get_width("abc") == 15);
+    TEST_ASSERT(file.location() == location);
+
+    return true;
+  }
+
+  bool font_kerning_case() {
+    using namespace ux;
+
+    // enough unsorted pairs for a dense table
+    const var::StringView seconds = "AVWToea.";
+    var::Vector<sg_font_kerning_pair_t> kerning_pairs;
+    for (size_t i = 0; i < seconds.length(); i++) {
+      for (u16 first = '!'; first <= '~'; first++) {
+        sg_font_kerning_pair_t pair = {};
+        pair.unicode_first = first;
+        pair.unicode_second = u8(seconds.at(i));
+        pair.horizontal_kerning = (first + 3 * pair.unicode_second) % 5 - 2;
+        kerning_pairs.push_back(pair);
+      }
+    }
+
+    // a value that does not fit in the dense table needs the index
+    var::Vector<sg_font_kerning_pair_t> indexed_pairs = kerning_pairs;
+    sg_font_kerning_pair_t wide_pair = {};
+    wide_pair.unicode_first = '~';
+    wide_pair.unicode_second = '~';
+    wide_pair.horizontal_kerning = 200;
+    indexed_pairs.push_back(wide_pair);
+
+    {
+      fs::DataFile file;
+      file.write(create_font_data(kerning_pairs)).seek(0);
+      sgfx::Font font(&file);
+      TEST_ASSERT(font.kerning_pair_count() == kerning_pairs.count());
+      TEST_ASSERT(is_kerning_measured(font, kerning_pairs));
+      font.set_kerning_enabled(false);
+      TEST_ASSERT(is_kerning_measured(font, kerning_pairs));
+    }
+
+    {
+      fs::DataFile file;
+      file.write(create_font_data(indexed_pairs)).seek(0);
+      sgfx::Font font(&file);
+      TEST_ASSERT(is_kerning_measured(font, indexed_pairs));
+    }
+
+    // fonts used in place search the sorted pairs
+    {
+      const var::Data font_data = create_font_data(indexed_pairs);
+      sgfx::Font font((var::View(font_data)));
+      TEST_ASSERT(is_kerning_measured(font, indexed_pairs));
+    }
+
+    return true;
+  }
+
+  bool font_view_case() {
+    using namespace ux;
+
+    var::Vector<sg_font_kerning_pair_t> kerning_pairs;
+    sg_font_kerning_pair_t pair = {};
+    pair.unicode_first = 'A';
+    pair.unicode_second = 'V';
+    pair.horizontal_kerning = 2;
+    kerning_pairs.push_back(pair);
+
+    const var::Data font_data = create_font_data(kerning_pairs);
+    const size_t size = font_data.size();
+
+    // place the font so that its canvases are word aligned
+    const u32 header_size
+      = reinterpret_cast<const sg_font_header_t *>(font_data.data_u8())
+          ->size;
+    const size_t word_size = sizeof(sg_bmap_data_t);
+    const size_t aligned_offset
+      = (word_size - header_size % word_size) % word_size;
+
+    // heap memory is word aligned
+    var::Data aligned_memory(size + word_size);
+    var::View aligned_view(aligned_memory.data_u8() + aligned_offset, size);
+    aligned_view.copy(font_data);
+    sgfx::Font aligned(aligned_view);
+    TEST_ASSERT(aligned.is_valid());
+    TEST_ASSERT(aligned.is_zero_copy());
+    TEST_ASSERT(aligned.source() == aligned_view.to_const_u8() + header_size);
+
+    // one byte over, the font is copied to aligned memory
+    var::Data shifted_memory(size + word_size + 1);
+    var::View shifted_view(
+      shifted_memory.data_u8() + aligned_offset + 1,
+      size);
+    shifted_view.copy(font_data);
+    sgfx::Font shifted(shifted_view);
+    TEST_ASSERT(shifted.is_valid());
+    TEST_ASSERT(shifted.is_zero_copy() == false);
+    const u8 *source = static_cast<const u8 *>(shifted.source());
+    TEST_ASSERT(
+      (source < shifted_memory.data_u8())
+      || (source >= shifted_memory.data_u8() + shifted_memory.size()));
+
+    // one kerning pair (6 bytes) leaves the canvases off a word in the
+    // copy unless it is padded
+    TEST_ASSERT(header_size % word_size != 0);
+    TEST_ASSERT(reinterpret_cast<uintptr_t>(source) % word_size == 0);
+
+    // both draw and measure the same way
+    const char *string = "AVA the quick brown fox";
+    TEST_ASSERT(is_kerning_measured(aligned, kerning_pairs));
+    TEST_ASSERT(is_kerning_measured(shifted, kerning_pairs));
+    TEST_ASSERT(aligned.get_width(string) == shifted.get_width(string));
+
+    sgfx::BitmapData aligned_bitmap(
+      sgfx::Area(128, 8),
+      sgfx::Bitmap::BitsPerPixel::x1);
+    sgfx::BitmapData shifted_bitmap(
+      sgfx::Area(128, 8),
+      sgfx::Bitmap::BitsPerPixel::x1);
+    aligned_bitmap.clear().set_pen(sgfx::Pen().set_color(1));
+    shifted_bitmap.clear().set_pen(sgfx::Pen().set_color(1));
+    aligned.draw(string, aligned_bitmap, sgfx::Point());
+    shifted.draw(string, shifted_bitmap, sgfx::Point());
+    TEST_ASSERT(aligned_bitmap.get_pixel(sgfx::Point(0, 0)) == 1);
+    TEST_ASSERT(aligned_bitmap.view() == shifted_bitmap.view());
+
+    return true;
+  }
+
+  bool canvas_cache_case() {
+    using namespace ux;
+
+    // three 32x8 1bpp canvases (32 bytes each) filled with their offset
+    const sgfx::Area area(32, 8);
+    const u32 canvas_size = 32;
+    var::Data canvas_data(canvas_size * 3);
+    for (u32 i = 0; i < 3; i++) {
+      var::View(canvas_data.data_u8() + i * canvas_size, canvas_size)
+        .fill<u8>(i);
+    }
+    fs::DataFile file;
+    file.write(canvas_data).seek(0);
+
+    // returns the first two pixels of the canvas at offset
+    auto get = [&](u32 offset) {
+      const sgfx::Bitmap *canvas = sgfx::CanvasCache::get(
+        &file,
+        offset,
+        area,
+        sgfx::Bitmap::BitsPerPixel::x1);
+      return canvas->get_pixel(sgfx::Point(0, 0))
+             | (canvas->get_pixel(sgfx::Point(1, 0)) << 1);
+    };
+
+    const size_t budget = sgfx::CanvasCache::budget();
+    sgfx::CanvasCache::clear();
+    sgfx::CanvasCache::set_budget(canvas_size * 2);
+    sgfx::CanvasCache::reset_statistics();
+
+    TEST_ASSERT(get(0) == 0);
+    TEST_ASSERT(get(canvas_size) == 1);
+    TEST_ASSERT(get(0) == 0);
+    TEST_ASSERT(sgfx::CanvasCache::hit_count() == 1);
+    TEST_ASSERT(sgfx::CanvasCache::miss_count() == 2);
+
+    // the least recently used canvas is discarded to make room
+    TEST_ASSERT(get(canvas_size * 2) == 2);
+    TEST_ASSERT(sgfx::CanvasCache::calculate_size() == canvas_size * 2);
+    TEST_ASSERT(get(0) == 0);
+    TEST_ASSERT(sgfx::CanvasCache::hit_count() == 2);
+    TEST_ASSERT(get(canvas_size) == 1);
+    TEST_ASSERT(sgfx::CanvasCache::miss_count() == 4);
+
+    // a smaller budget discards canvases right away
+    sgfx::CanvasCache::set_budget(canvas_size);
+    TEST_ASSERT(sgfx::CanvasCache::calculate_size() == canvas_size);
+    sgfx::CanvasCache::remove(&file);
+    TEST_ASSERT(sgfx::CanvasCache::calculate_size() == 0);
+
+    sgfx::CanvasCache::set_budget(budget);
+    return true;
+  }
+
+  bool text_run_cache_case() {
+    using namespace ux;
+
+    var::Data font_data = create_font_data();
+    sgfx::Font font((var::View(font_data)));
+    TEST_ASSERT(font.is_valid());
+
+    sgfx::Point offset;
+    auto get = [&](const char *string) {
+      return sgfx::TextRunCache::get(font, string, offset);
+    };
+
+    // the cache is disabled until a budget is set
+    const size_t budget = sgfx::TextRunCache::budget();
+    sgfx::TextRunCache::clear();
+    sgfx::TextRunCache::set_budget(0);
+    TEST_ASSERT(get("abc") == nullptr);
+
+    sgfx::TextRunCache::set_budget(4096);
+    sgfx::TextRunCache::reset_statistics();
+    const sgfx::Bitmap *run = get("abc");
+    TEST_ASSERT(run != nullptr);
+    TEST_ASSERT(sgfx::TextRunCache::miss_count() == 1);
+
+    // the glyphs are solid, the run starts at the first glyph
+    TEST_ASSERT(run->width() >= 14);
+    TEST_ASSERT(run->height() == 8);
+    TEST_ASSERT(run->get_pixel(sgfx::Point(0, 0)) == 1);
+    TEST_ASSERT(run->get_pixel(sgfx::Point(4, 0)) == 0);
+    const sgfx::Point run_offset = offset;
+    const size_t run_size = sgfx::TextRunCache::calculate_size();
+    TEST_ASSERT(run_size > 0);
+
+    TEST_ASSERT(get("abc") == run);
+    TEST_ASSERT(offset == run_offset);
+    TEST_ASSERT(sgfx::TextRunCache::hit_count() == 1);
+
+    // runs of the same length use the same size; keep room for two
+    sgfx::TextRunCache::set_budget(run_size * 2);
+    TEST_ASSERT(get("def") != nullptr);
+    TEST_ASSERT(get("abc") != nullptr);
+    TEST_ASSERT(sgfx::TextRunCache::hit_count() == 2);
+
+    // "def" is the least recently used run
+    TEST_ASSERT(get("ghi") != nullptr);
+    TEST_ASSERT(sgfx::TextRunCache::calculate_size() == run_size * 2);
+    TEST_ASSERT(get("abc") != nullptr);
+    TEST_ASSERT(sgfx::TextRunCache::hit_count() == 3);
+    TEST_ASSERT(get("def") != nullptr);
+    TEST_ASSERT(sgfx::TextRunCache::miss_count() == 4);
+
+    // runs larger than the budget are not cached
+    TEST_ASSERT(get("abcdefghijklmnopqrstuvwxyz") == nullptr);
+
+    // runs keep their own copy of the string
+    {
+      char buffer[] = "abc";
+      sgfx::TextRunCache::reset_statistics();
+      TEST_ASSERT(get(buffer) != nullptr);
+      TEST_ASSERT(sgfx::TextRunCache::hit_count() == 1);
+      buffer[2] = 'x';
+      TEST_ASSERT(get(buffer) != nullptr);
+      TEST_ASSERT(sgfx::TextRunCache::miss_count() == 1);
+    }
+
+    sgfx::TextRunCache::remove(font.source());
+    TEST_ASSERT(sgfx::TextRunCache::calculate_size() == 0);
+
+    sgfx::TextRunCache::set_budget(budget);
+    return true;
+  }
+
+  bool utf8_decode_case() {
+    using namespace ux;
+
+    // returns the code points of value with the offset after each one
+    auto decode = [](const var::StringView value) {
+      var::Vector<u32> result;
+      size_t offset = 0;
+      while (offset < value.length()) {
+        result.push_back(sgfx::Font::decode_utf8(value, offset));
+        result.push_back(offset);
+      }
+      return result;
+    };
+
+    const u32 replacement = sgfx::Font::replacement_character();
+    auto is_decoded = [&](
+                        const var::StringView value,
+                        const var::Vector<u32> &expected) {
+      const var::Vector<u32> result = decode(value);
+      return var::View(result) == var::View(expected);
+    };
+
+    TEST_ASSERT(is_decoded("A~", {'A', 1, '~', 2}));
+    TEST_ASSERT(is_decoded("\xc3\xa9", {0xe9, 2}));
+    TEST_ASSERT(is_decoded("\xe4\xb8\x80", {0x4e00, 3}));
+    TEST_ASSERT(is_decoded("\xf0\x9f\x98\x80", {0x1f600, 4}));
+    TEST_ASSERT(is_decoded(
+      "a\xce\xb1\xe4\xb8\x80\xf0\x9f\x98\x80",
+      {'a', 1, 0x3b1, 3, 0x4e00, 6, 0x1f600, 10}));
+
+    // a byte that is not a continuation starts the next code point
+    TEST_ASSERT(is_decoded("\xc3A", {replacement, 1, 'A', 2}));
+    TEST_ASSERT(is_decoded("\xe4\xb8A", {replacement, 2, 'A', 3}));
+
+    // stray continuation bytes and invalid lead bytes
+    TEST_ASSERT(is_decoded("\x80A", {replacement, 1, 'A', 2}));
+    TEST_ASSERT(is_decoded("\xffA", {replacement, 1, 'A', 2}));
+
+    // truncated at the end of the string
+    TEST_ASSERT(is_decoded("A\xe4\xb8", {'A', 1, replacement, 3}));
+    TEST_ASSERT(is_decoded("\xf0\x9f", {replacement, 2}));
+
+    return true;
+  }
+
+  bool font_unicode_case() {
+    using namespace ux;
+
+    // more characters than the pages that are kept (8 x 32)
+    const var::Vector<sg_font_unicode_range_t> range_list
+      = {{'A', 26, 0}, {0x3b1, 25, 26}, {0x4e00, 300, 51}, {0x1f600, 10, 351}};
+
+    fs::DataFile file;
+    file.write(create_unicode_font_data(range_list)).seek(0);
+    sgfx::Font font(&file);
+    TEST_ASSERT(font.is_valid());
+    TEST_ASSERT(font.is_unicode());
+    TEST_ASSERT(font.size() == 361);
+
+    // sweep twice so the pages are reused
+    for (u32 sweep = 0; sweep < 2; sweep++) {
+      for (const sg_font_unicode_range_t &range : range_list) {
+        for (u32 i = 0; i < range.count; i++) {
+          const u32 unicode = range.first + i;
+          const sg_font_char_t *character = font.find_character(unicode);
+          TEST_ASSERT(character != nullptr);
+          TEST_ASSERT(character->id == u16(unicode));
+          TEST_ASSERT(character->advance_x == get_unicode_advance(unicode));
+        }
+      }
+    }
+
+    // code points between and around the ranges
+    for (const u32 unicode :
+         {u32('@'), u32('['), u32(0x3b0), u32(0x3ca), u32(0x4dff),
+          u32(0x4e00 + 300), u32(0x1f5ff), u32(0x1f60a), u32(0x10ffff)}) {
+      TEST_ASSERT(font.find_character(unicode) == nullptr);
+    }
+
+    // every byte of a character has the advance after it
+    const var::StringView string
+      = "A\xce\xb1\xe4\xb8\x80\xf0\x9f\x98\x80";
+    sg_int_t advance_list[10];
+    TEST_ASSERT(font.measure(string, advance_list, 10) == 10);
+    const sg_int_t a = get_unicode_advance('A');
+    const sg_int_t alpha = a + get_unicode_advance(0x3b1);
+    const sg_int_t cjk = alpha + get_unicode_advance(0x4e00);
+    const sg_int_t emoji = cjk + get_unicode_advance(0x1f600);
+    const sg_int_t expected[10]
+      = {a, alpha, alpha, cjk, cjk, cjk, emoji, emoji, emoji, emoji};
+    TEST_ASSERT(memcmp(advance_list, expected, sizeof(expected)) == 0);
+    TEST_ASSERT(font.get_width(string) == emoji);
+
+    // the same font used in place
+    const var::Data font_data = create_unicode_font_data(range_list);
+    sgfx::Font view_font((var::View(font_data)));
+    TEST_ASSERT(view_font.is_unicode());
+    TEST_ASSERT(view_font.get_width(string) == emoji);
+    TEST_ASSERT(view_font.find_character(0x4e00 + 299)->id == 0x4e00 + 299);
+    TEST_ASSERT(view_font.find_character(0x4e00 + 300) == nullptr);
+
+    return true;
+  }
+
+  bool glyph_run_case() {
+    using namespace ux;
+
+    // a patterned canvas shows which part of a clipped glyph is drawn
+    var::Data font_data = create_font_data();
+    const u32 header_size
+      = reinterpret_cast<const sg_font_header_t *>(font_data.data_u8())
+          ->size;
+    for (u32 i = header_size; i < font_data.size(); i++) {
+      font_data.data_u8()[i] = u8(i * 37 + 11);
+    }
+    sgfx::Font font((var::View(font_data)));
+    TEST_ASSERT(font.is_valid());
+
+    sgfx::BitmapData canvas(
+      sgfx::Area(32, 8),
+      sgfx::Bitmap::BitsPerPixel::x1);
+    canvas.view().copy(
+      var::View(font_data.data_u8() + header_size, canvas.view().size()));
+
+    // every glyph is 4x8 at the top left of the canvas, advance 5
+    const char *string = "ABCDEFGHIJ";
+    const sgfx::Region glyph_region(sgfx::Point(), sgfx::Area(4, 8));
+
+    // the first point keeps the run inside the bitmap (one clip for
+    // the run), the others cross an edge (each glyph is clipped)
+    const sgfx::Point point_list[] = {
+      sgfx::Point(3, 0),
+      sgfx::Point(20, 0),
+      sgfx::Point(-7, 0),
+      sgfx::Point(2, -3),
+      sgfx::Point(2, 5)};
+
+    const sgfx::Bitmap::BitsPerPixel bits_per_pixel_list[]
+      = {sgfx::Bitmap::BitsPerPixel::x1,
+         sgfx::Bitmap::BitsPerPixel::x2,
+         sgfx::Bitmap::BitsPerPixel::x4,
+         sgfx::Bitmap::BitsPerPixel::x8};
+
+    for (const auto bits_per_pixel : bits_per_pixel_list) {
+      sgfx::BitmapData run_bitmap(sgfx::Area(56, 8), bits_per_pixel);
+      sgfx::BitmapData expected_bitmap(sgfx::Area(56, 8), bits_per_pixel);
+      const sgfx::Pen pen = sgfx::Pen().set_color(3).set_zero_transparent();
+
+      for (const sgfx::Point &point : point_list) {
+        run_bitmap.clear();
+        run_bitmap.set_pen(pen);
+        font.draw(string, run_bitmap, point);
+
+        expected_bitmap.clear();
+        expected_bitmap.set_pen(pen);
+        for (u32 i = 0; string[i]; i++) {
+          // sg_draw_sub_bitmap() does not move the source region for
+          // negative points, so the top and left edges are clipped here
+          const sg_int_t x = point.x() + i * 5;
+          const sg_int_t y = point.y();
+          const sg_int_t canvas_x = x < 0 ? -x : 0;
+          const sg_int_t canvas_y = y < 0 ? -y : 0;
+          const sg_int_t width = glyph_region.width() - canvas_x;
+          const sg_int_t height = glyph_region.height() - canvas_y;
+          if (width > 0 && height > 0) {
+            expected_bitmap.draw_sub_bitmap(
+              sgfx::Point(x + canvas_x, y + canvas_y),
+              canvas,
+              sgfx::Region(
+                sgfx::Point(canvas_x, canvas_y),
+                sgfx::Area(width, height)));
+          }
+        }
+
+        TEST_ASSERT(
+          run_bitmap.calculate_active_region().area().width() > 0);
+        TEST_ASSERT(run_bitmap.view() == expected_bitmap.view());
+      }
+    }
+
+    return true;
+  }
+
+  bool blend_table_case() {
+    using namespace ux;
+    using Style = sgfx::Theme::Style;
+    using State = sgfx::Theme::State;
+    const auto x4 = sgfx::Bitmap::BitsPerPixel::x4;
+
+    const var::StringView path = "blend_theme.dat";
+    fs::File theme_file;
+    sgfx::Theme theme(theme_file);
+    theme.create(
+      path,
+      fs::File::IsOverwrite::yes,
+      x4,
+      sgfx::Palette::PixelFormat::rgb888);
+
+    sgfx::Palette palette;
+    palette.set_pixel_format(sgfx::Palette::PixelFormat::rgb888)
+      .set_color_count(sgfx::Palette::ColorCount::x4bpp)
+      .create_gradient(sgfx::PaletteColor("#ffffff"));
+    theme.write_palette(Style::dark, State::default_, palette);
+
+    // a color outside the palette leaves the table invalid, not an error
+    {
+      const sgfx::BlendTable invalid(palette, 16, x4);
+      TEST_ASSERT(invalid.is_valid() == false);
+      TEST_ASSERT(api::ExecutionContext::is_error() == false);
+    }
+
+    // tables are created once
+    const sgfx::BlendTable *table
+      = theme.get_blend_table(Style::dark, State::default_, x4);
+    TEST_ASSERT(table->is_valid());
+    TEST_ASSERT(table->color() == theme.text_color());
+    TEST_ASSERT(
+      theme.get_blend_table(Style::dark, State::default_, x4) == table);
+
+    const var::Data font_data
+      = create_font_data(var::Vector<sg_font_kerning_pair_t>(), 4);
+    sgfx::Font font((var::View(font_data)));
+    TEST_ASSERT(font.is_antialiased());
+
+    sgfx::BitmapData bitmap(sgfx::Area(32, 8), x4);
+    DrawingScaledAttributes attributes;
+    attributes.set(bitmap, sgfx::Point(), bitmap.area());
+    const sg_color_t background = 3;
+
+    draw::Text text;
+    text.set_font(&font)
+      .set_string("A")
+      .set_color(theme.text_color())
+      .set_blend_theme(&theme, Style::dark, State::default_)
+      .set_align_left()
+      .set_align_top();
+
+    // the half-covered glyph is blended with the background
+    auto draw_text = [&]() {
+      bitmap.set_pen(sgfx::Pen().set_color(background))
+        .draw_rectangle(sgfx::Region(sgfx::Point(), bitmap.area()));
+      text.draw(attributes);
+      return bitmap.get_pixel(sgfx::Point(0, 0));
+    };
+
+    const sg_color_t blended = table->get(background, 7);
+    TEST_ASSERT(blended != background);
+    TEST_ASSERT(blended != theme.text_color());
+    TEST_ASSERT(draw_text() == blended);
+    TEST_ASSERT(bitmap.get_pixel(sgfx::Point(4, 0)) == background);
+
+    // a new palette creates a new table
+    palette.create_gradient(
+      sgfx::PaletteColor("#ffffff"),
+      sgfx::Palette::IsAscending::no);
+    theme.write_palette(Style::dark, State::default_, palette);
+    const sgfx::BlendTable expected(
+      palette,
+      theme.text_color(),
+      sgfx::BlendTable::BitsPerPixel::x4);
+    TEST_ASSERT(
+      theme.get_blend_table(Style::dark, State::default_, x4)
+        ->get(background, 7)
+      == expected.get(background, 7));
+    TEST_ASSERT(draw_text() == expected.get(background, 7));
+
+    theme_file = fs::File();
+    fs::FileSystem().remove(path);
+    return true;
+  }
+
+  bool asset_pack_case() {
+    using namespace ux;
+    using AssetPack = fmt::AssetPack;
+    using Style = sgfx::Font::Style;
+
+    const var::Data font_data = create_font_data();
+    const u8 bitmap_bytes[5] = {1, 2, 3, 4, 5};
+    const u8 icon_bytes[3] = {6, 7, 8};
+
+    // the items are not in index order
+    var::Vector<AssetPack::Item> item_list;
+    item_list.push_back(AssetPack::Item()
+                          .set_type(AssetPack::Type::font)
+                          .set_name("sans")
+                          .set_style(Style::bold)
+                          .set_point_size(16)
+                          .set_data(font_data));
+    item_list.push_back(AssetPack::Item()
+                          .set_type(AssetPack::Type::vector_icon)
+                          .set_name("check")
+                          .set_data(var::View(icon_bytes)));
+    item_list.push_back(AssetPack::Item()
+                          .set_type(AssetPack::Type::font)
+                          .set_name("sans")
+                          .set_style(Style::regular)
+                          .set_point_size(12)
+                          .set_data(font_data));
+    item_list.push_back(AssetPack::Item()
+                          .set_type(AssetPack::Type::bitmap)
+                          .set_name("logo")
+                          .set_data(var::View(bitmap_bytes)));
+    item_list.push_back(AssetPack::Item()
+                          .set_type(AssetPack::Type::font)
+                          .set_name("mono")
+                          .set_style(Style::regular)
+                          .set_point_size(12)
+                          .set_data(font_data));
+
+    fs::DataFile file;
+    AssetPack::save(file, item_list);
+
+    AssetPack pack((var::View(file.data())));
+    TEST_ASSERT(pack.is_valid());
+    TEST_ASSERT(pack.count() == item_list.count());
+
+    // the index is sorted and the assets are word aligned
+    for (u32 i = 0; i < pack.count(); i++) {
+      const AssetPack::Entry entry = pack.at(i);
+      TEST_ASSERT(
+        (entry.data().to_const_u8() - file.data().data_u8()) % 4 == 0);
+      if (i > 0) {
+        const AssetPack::Entry previous = pack.at(i - 1);
+        TEST_ASSERT(
+          (previous.type() < entry.type())
+          || ((previous.type() == entry.type())
+              && (strcmp(previous.name().data(), entry.name().data())
+                  <= 0)));
+      }
+    }
+    TEST_ASSERT(pack.at(pack.count()).is_valid() == false);
+
+    const int bold = pack.find(AssetPack::Type::font, "sans", Style::bold, 16);
+    TEST_ASSERT(bold >= 0);
+    TEST_ASSERT(pack.at(bold).name() == "sans");
+    TEST_ASSERT(pack.at(bold).style() == Style::bold);
+    TEST_ASSERT(pack.at(bold).point_size() == 16);
+    TEST_ASSERT(pack.at(bold).data() == var::View(font_data));
+
+    // fonts in the pack are used in place
+    sgfx::Font font(pack.at(bold).data());
+    TEST_ASSERT(font.is_valid());
+    TEST_ASSERT(font.get_width("AB") == 10);
+
+    // the lowest style and point size is found first
+    const int sans = pack.find(AssetPack::Type::font, "sans");
+    TEST_ASSERT(sans >= 0);
+    TEST_ASSERT(pack.at(sans).style() == Style::regular);
+    TEST_ASSERT(pack.at(sans).point_size() == 12);
+    const int mono = pack.find(AssetPack::Type::font, "mono");
+    TEST_ASSERT(mono >= 0);
+    TEST_ASSERT(pack.find(AssetPack::Type::font) == mono);
+
+    const int logo = pack.find(AssetPack::Type::bitmap, "logo");
+    TEST_ASSERT(logo >= 0);
+    TEST_ASSERT(pack.at(logo).data() == var::View(bitmap_bytes));
+    const int check = pack.find(AssetPack::Type::vector_icon);
+    TEST_ASSERT(check >= 0);
+    TEST_ASSERT(pack.at(check).name() == "check");
+    TEST_ASSERT(pack.at(check).data() == var::View(icon_bytes));
+
+    // missing assets
+    TEST_ASSERT(pack.find(AssetPack::Type::icon_font) < 0);
+    TEST_ASSERT(pack.find(AssetPack::Type::bitmap, "logos") < 0);
+    TEST_ASSERT(
+      pack.find(AssetPack::Type::font, "sans", Style::bold, 12) < 0);
+    TEST_ASSERT(
+      pack.find(AssetPack::Type::font, "sans", Style::regular, 16) < 0);
+
+    // packs are checked when they are loaded
+    var::Data corrupt_data(file.data().size());
+    var::View(corrupt_data).copy(file.data());
+    corrupt_data.data_u8()[0] ^= 0xff;
+    AssetPack corrupt((var::View(corrupt_data)));
+    TEST_ASSERT(corrupt.is_valid() == false);
+    api::ExecutionContext::reset_error();
+
+    return true;
+  }
+
+  bool text_file_area_case() {
+    using namespace ux;
+    component_context();
+
+    // short lines are indexed first so the lines per byte of the
+    // index is more than the rest of the file
+    const u32 line_count = 2000;
+    const u32 short_line_count = 500;
+    auto create_lines = [&](u32 first) {
+      fs::DataFile result;
+      char line[32];
+      for (unsigned int i = first; i < line_count; i++) {
+        const int length
+          = i < short_line_count
+              ? snprintf(line, sizeof(line), "%u\n", i)
+              : snprintf(line, sizeof(line), "line %u xxxx\n", i);
+        result.write(var::View(line, length));
+      }
+      result.seek(0);
+      return result;
+    };
+
+    // 1bpp themes fill components with the text color
+    sgfx::BitmapData bitmap(
+      sgfx::Area(128, 64),
+      sgfx::Bitmap::BitsPerPixel::x2);
+    DrawingScaledAttributes attributes;
+    attributes.set(bitmap, sgfx::Point(), bitmap.area());
+
+    // the hash of the page drawn by a file that starts at line
+    auto draw_reference = [&](u32 line) {
+      fs::DataFile file = create_lines(line);
+      var::Data page_buffer(256);
+      TextFileArea area(
+        "reference",
+        TextFileArea::Construct().set_source(&file).set_page_buffer(
+          page_buffer));
+      area.set_text_height(1000);
+      area.draw(attributes);
+      return bitmap.calculate_hash();
+    };
+
+    fs::DataFile file = create_lines(0);
+    var::Data page_buffer(256);
+    TextFileArea area(
+      "textFileArea",
+      TextFileArea::Construct().set_source(&file).set_page_buffer(page_buffer));
+    area.set_text_height(1000);
+
+    // drawing selects the font and width that lines are wrapped with
+    area.draw(attributes);
+    TEST_ASSERT(bitmap.calculate_hash() == draw_reference(0));
+    area.handle_event(SystemEvent::periodic());
+    TEST_ASSERT(area.is_line_index_complete() == false);
+
+    // jumping past the index does not read the lines before the page
+    area.scroll_to(1500);
+    TEST_ASSERT(area.scroll() == 1500);
+    TEST_ASSERT(area.is_line_index_complete() == false);
+    area.draw(attributes);
+    const u64 estimated_hash = bitmap.calculate_hash();
+    TEST_ASSERT(estimated_hash != draw_reference(0));
+
+    // the line number is corrected when the index reaches the page
+    while (area.is_line_index_complete() == false) {
+      area.handle_event(SystemEvent::periodic());
+    }
+    const size_t line = area.scroll();
+    TEST_ASSERT(line > short_line_count);
+    TEST_ASSERT(line < 1500);
+    TEST_ASSERT(area.scroll_total() == line_count);
+    area.draw(attributes);
+    TEST_ASSERT(bitmap.calculate_hash() == estimated_hash);
+    TEST_ASSERT(estimated_hash == draw_reference(line));
+
+    // indexed lines are exact in both directions
+    area.scroll_to(line - 100);
+    TEST_ASSERT(area.scroll() == line - 100);
+    area.draw(attributes);
+    TEST_ASSERT(bitmap.calculate_hash() == draw_reference(line - 100));
+
+    area.scroll_to(1600);
+    TEST_ASSERT(area.scroll() == 1600);
+    area.draw(attributes);
+    TEST_ASSERT(bitmap.calculate_hash() == draw_reference(1600));
+
+    area.scroll_to(10);
+    area.draw(attributes);
+    TEST_ASSERT(bitmap.calculate_hash() == draw_reference(10));
+
+    // the ends are lines like any other
+    area.scroll_bottom();
+    TEST_ASSERT(area.scroll() == line_count - 1);
+    area.scroll_top();
+    TEST_ASSERT(area.scroll() == 0);
+    area.draw(attributes);
+    TEST_ASSERT(bitmap.calculate_hash() == draw_reference(0));
+
+    // a last line without a newline is indexed once the file stops
+    // growing and indexed again when it grows
+    fs::DataFile growing_file;
+    growing_file.write(var::StringView("first\nsecond")).seek(0);
+    TextFileArea growing_area(
+      "growingFileArea",
+      TextFileArea::Construct().set_source(&growing_file).set_page_buffer(
+        page_buffer));
+    growing_area.set_text_height(1000);
+    growing_area.draw(attributes);
+    growing_area.handle_event(SystemEvent::periodic());
+    TEST_ASSERT(growing_area.is_line_index_complete() == false);
+    growing_area.handle_event(SystemEvent::periodic());
+    TEST_ASSERT(growing_area.is_line_index_complete());
+    TEST_ASSERT(growing_area.scroll_total() == 2);
+
+    growing_file.seek(0, fs::File::Whence::end)
+      .write(var::StringView(" line\nthird\n"));
+    growing_area.handle_event(SystemEvent::periodic());
+    TEST_ASSERT(growing_area.is_line_index_complete());
+    TEST_ASSERT(growing_area.scroll_total() == 3);
+
+    return true;
+  }
+
+  bool icon_font_case() {
+    using namespace ux;
+
+    fs::DataFile file;
+    write_icon_font(file, "left", "right");
+    sgfx::IconFont font(&file);
+    TEST_ASSERT(font.count() == 2);
+    TEST_ASSERT(font.find("left") == 0);
+    TEST_ASSERT(font.find("right") == 1);
+    TEST_ASSERT(font.find("up") == font.count());
+    const u32 revision = font.revision();
+
+    // offsets that were found before a refresh are not valid after it
+    write_icon_font(file, "right", "left");
+    font.refresh();
+    TEST_ASSERT(font.revision() != revision);
+    TEST_ASSERT(font.find("left") == 1);
+    TEST_ASSERT(font.get_info(font.find("left")).width() == 6);
+
+    // fonts do not share revisions
+    sgfx::IconFont other(&file);
+    TEST_ASSERT(other.revision() != font.revision());
+
+    return true;
+  }
+
+  bool rich_text_case() {
+    using namespace ux;
+
+    class TestRichText : public draw::RichText {
+    public:
+      using RichText::set_color;
+      using RichText::set_icon_font;
+      using RichText::set_text_font;
+      using RichText::set_value;
+    };
+
+    var::Data font_data = create_font_data();
+    sgfx::Font text_font((var::View(font_data)));
+    fs::DataFile icon_file;
+    write_icon_font(icon_file, "left", "right");
+    sgfx::IconFont icon_font(&icon_file);
+
+    sgfx::BitmapData bitmap(
+      sgfx::Area(128, 16),
+      sgfx::Bitmap::BitsPerPixel::x1);
+    DrawingScaledAttributes attributes;
+    attributes.set(bitmap, sgfx::Point(), bitmap.area());
+
+    const size_t capacity = draw::RichText::run_cache_capacity();
+    draw::RichText::set_run_cache_capacity(4);
+    draw::RichText::clear_run_cache();
+
+    char value[] = "ab :left: cd";
+    TestRichText rich_text;
+    // the setters are protected so they are not chained
+    rich_text.set_text_font(&text_font);
+    rich_text.set_icon_font(&icon_font);
+    rich_text.set_value(value);
+    rich_text.set_color(1);
+    auto draw_hash = [&]() {
+      bitmap.clear();
+      rich_text.draw(attributes);
+      return bitmap.calculate_hash();
+    };
+
+    const u32 hit_count = draw::RichText::run_cache_hit_count();
+    const u32 miss_count = draw::RichText::run_cache_miss_count();
+    const u64 hash = draw_hash();
+    TEST_ASSERT(draw_hash() == hash);
+    TEST_ASSERT(draw::RichText::run_cache_hit_count() == hit_count + 1);
+    TEST_ASSERT(draw::RichText::run_cache_miss_count() == miss_count + 1);
+
+    // lists are found by the characters, not where they are stored
+    char copy[sizeof(value)];
+    memcpy(copy, value, sizeof(value));
+    rich_text.set_value(copy);
+    TEST_ASSERT(draw_hash() == hash);
+    TEST_ASSERT(draw::RichText::run_cache_hit_count() == hit_count + 2);
+
+    // the same length with other characters is another list (the
+    // glyphs of the test font are the same, so a space is used)
+    copy[1] = ' ';
+    TEST_ASSERT(draw_hash() != hash);
+    TEST_ASSERT(draw::RichText::run_cache_miss_count() == miss_count + 2);
+
+    draw::RichText::set_run_cache_capacity(capacity);
+    return true;
+  }
+
+  bool text_layout_case() {
+    using namespace ux;
+
+    var::Data font_data = create_font_data();
+    sgfx::Font font((var::View(font_data)));
+    TEST_ASSERT(font.is_valid());
+
+    sgfx::BitmapData bitmap(
+      sgfx::Area(128, 64),
+      sgfx::Bitmap::BitsPerPixel::x1);
+    DrawingScaledAttributes attributes;
+    attributes.set(bitmap, sgfx::Point(), bitmap.area());
+
+    draw::TextBox text_box;
+    text_box.set_font(&font)
+      .set_string("the quick brown fox jumps over the lazy dog\n"
+                  "pack my box with five dozen liquor jugs");
+    draw::Text text;
+    text.set_font(&font).set_string("steady state");
+
+    // the first draw sizes the shared scratch buffers
+    text_box.draw(attributes);
+    text.draw(attributes);
+
+    AllocationCounter::reset();
+    for (u32 i = 0; i < 8; i++) {
+      text_box.draw(attributes);
+      text.draw(attributes);
+    }
+    TEST_ASSERT(AllocationCounter::count() == 0);
+
+    // the lines are wrapped again when the string or width changes
+    TEST_ASSERT(text_box.first_line_length() > 11);
+    text_box.set_string("pack my box");
+    text_box.draw(attributes);
+    TEST_ASSERT(text_box.first_line_length() == 11);
+    attributes.set(bitmap, sgfx::Point(), sgfx::Area(40, 64));
+    text_box.draw(attributes);
+    TEST_ASSERT(text_box.first_line_length() < 11);
+
+    // components set the string each time they draw. Changing the
+    // characters in place shows whether the lines are wrapped again:
+    // the lines are kept until the string is set or refreshed.
+    component_context();
+    sgfx::BitmapData area_bitmap(
+      sgfx::Area(128, 64),
+      sgfx::Bitmap::BitsPerPixel::x2);
+    DrawingScaledAttributes area_attributes;
+    area_attributes.set(area_bitmap, sgfx::Point(), area_bitmap.area());
+
+    char display_text[] = "abc\ndef";
+    TextArea text_area("textLayoutArea");
+    text_area.set_display_text(display_text).set_text_height(1000);
+    text_area.draw(area_attributes);
+    const u64 two_line_hash = area_bitmap.calculate_hash();
+
+    display_text[3] = ' ';
+    text_area.draw(area_attributes);
+    TEST_ASSERT(area_bitmap.calculate_hash() == two_line_hash);
+    text_area.set_display_text(display_text);
+    text_area.draw(area_attributes);
+    TEST_ASSERT(area_bitmap.calculate_hash() != two_line_hash);
+
+    fs::DataFile file;
+    file.write(var::StringView("abc\ndef\n")).seek(0);
+    var::Data page_buffer(256);
+    TextFileArea file_area(
+      "textLayoutFileArea",
+      TextFileArea::Construct().set_source(&file).set_page_buffer(
+        page_buffer));
+    file_area.set_text_height(1000);
+    file_area.draw(area_attributes);
+    TEST_ASSERT(area_bitmap.calculate_hash() == two_line_hash);
+
+    page_buffer.data_u8()[3] = ' ';
+    file_area.draw(area_attributes);
+    TEST_ASSERT(area_bitmap.calculate_hash() == two_line_hash);
+
+    return true;
+  }
+
+  bool virtual_list_case() {
+    using namespace ux;
+    ComponentContext &context = component_context();
+
+    size_t entry_count = 100;
+    size_t bind_count = 0;
+    VirtualList &list = VirtualList::create("virtualList");
+    list.set_drawing_area(DrawingArea(1000, 1000));
+    list.set_data_source(
+      [&]() { return entry_count; },
+      [&](size_t index, ListItem &item) {
+        MCU_UNUSED_ARGUMENT(index);
+        MCU_UNUSED_ARGUMENT(item);
+        bind_count++;
+      });
+
+    // the rows are created and bound when the list is shown
+    context.controller.transition(list);
+    context.controller.distribute_event(SystemEvent::periodic());
+    const size_t row_count = list.component_list().count();
+    TEST_ASSERT(row_count == 7);
+    TEST_ASSERT(bind_count == row_count);
+
+    auto get_row_index = [&](size_t row) {
+      return list.get_index(list.component_list().at(row).component());
+    };
+    for (size_t row = 0; row < row_count; row++) {
+      TEST_ASSERT(get_row_index(row) == row);
+    }
+    TEST_ASSERT(list.get_index(&list) == VirtualList::npos);
+
+    // the overscan row above the first visible row is still bound
+    bind_count = 0;
+    list.scroll_to(1);
+    TEST_ASSERT(list.scroll_position() == list.item_height());
+    TEST_ASSERT(bind_count == 0);
+
+    // scrolling by one entry rebinds the row that left the top
+    list.scroll_to(2);
+    TEST_ASSERT(bind_count == 1);
+    TEST_ASSERT(get_row_index(0) == row_count);
+    TEST_ASSERT(get_row_index(1) == 1);
+
+    // rows past the last entry are not bound
+    bind_count = 0;
+    list.scroll_to(entry_count - 1);
+    TEST_ASSERT(
+      list.scroll_position() == entry_count * list.item_height() - 1000);
+    TEST_ASSERT(bind_count == 5);
+    const size_t unbound_row = entry_count % row_count;
+    TEST_ASSERT(get_row_index(unbound_row) == VirtualList::npos);
+    TEST_ASSERT(
+      list.component_list().at(unbound_row).component()->is_enabled()
+      == false);
+    TEST_ASSERT(get_row_index(99 % row_count) == 99);
+
+    // reloading binds every row again
+    bind_count = 0;
+    entry_count = 3;
+    list.reload();
+    TEST_ASSERT(list.scroll_position() == 0);
+    TEST_ASSERT(bind_count == entry_count);
+    for (size_t row = 0; row < row_count; row++) {
+      TEST_ASSERT(
+        get_row_index(row) == (row < entry_count ? row : VirtualList::npos));
+    }
+
+    // the list stays on the controller without the local callbacks
+    list.set_data_source(VirtualList::Count(), VirtualList::Bind());
+    return true;
+  }
+
+  bool text_buffer_case() {
+    using namespace ux;
+
+    TextBuffer buffer("hello world");
+    TEST_ASSERT(buffer.size() == 11);
+    TEST_ASSERT(buffer.piece_count() == 1);
+
+    // inserting in a piece splits it
+    buffer.insert(5, ",");
+    TEST_ASSERT(buffer.to_string() == "hello, world");
+    TEST_ASSERT(buffer.piece_count() == 3);
+
+    // typing after the last insert extends its piece
+    buffer.insert(6, "!");
+    TEST_ASSERT(buffer.to_string() == "hello,! world");
+    TEST_ASSERT(buffer.piece_count() == 3);
+
+    // inserting at a piece boundary does not split
+    buffer.insert(0, ">");
+    TEST_ASSERT(buffer.to_string() == ">hello,! world");
+    TEST_ASSERT(buffer.piece_count() == 4);
+    buffer.append("\n").append("x");
+    TEST_ASSERT(buffer.to_string() == ">hello,! world\nx");
+    TEST_ASSERT(buffer.piece_count() == 5);
+
+    // removing splits the pieces at both ends and drops those between
+    buffer.remove(3, 4);
+    TEST_ASSERT(buffer.to_string() == ">he! world\nx");
+    TEST_ASSERT(buffer.piece_count() == 5);
+    TEST_ASSERT(buffer.size() == 12);
+
+    buffer.remove(0, 1);
+    TEST_ASSERT(buffer.to_string() == "he! world\nx");
+    TEST_ASSERT(buffer.piece_count() == 4);
+
+    // edits outside the text are limited to the text
+    buffer.remove(5, 100);
+    TEST_ASSERT(buffer.to_string() == "he! w");
+    buffer.remove(5, 1);
+    TEST_ASSERT(buffer.size() == 5);
+    buffer.insert(100, "o");
+    TEST_ASSERT(buffer.to_string() == "he! wo");
+
+    char data[4];
+    TEST_ASSERT(buffer.read(1, var::View(data, 3)) == 3);
+    TEST_ASSERT(var::StringView(data, 3) == "e! ");
+    TEST_ASSERT(buffer.read(4, var::View(data, 4)) == 2);
+    TEST_ASSERT(var::StringView(data, 2) == "wo");
+    TEST_ASSERT(buffer.at(2) == '!');
+    TEST_ASSERT(buffer.at(buffer.size()) == 0);
+
+    buffer.clear();
+    TEST_ASSERT(buffer.is_empty());
+    TEST_ASSERT(buffer.piece_count() == 0);
+    TEST_ASSERT(buffer.append("new").to_string() == "new");
+
+    return true;
+  }
+
+  bool text_area_case() {
+    using namespace ux;
+    ComponentContext &context = component_context();
+    const sgfx::Bitmap &screen = context.device.bitmap();
+
+    // the hash of a text area that is drawn once with text
+    auto draw_reference = [&](const var::StringView text) {
+      sgfx::BitmapData bitmap(screen.area(), screen.bits_per_pixel());
+      DrawingScaledAttributes attributes;
+      attributes.set(bitmap, sgfx::Point(), bitmap.area());
+      TextArea reference("referenceArea");
+      reference.set_text_height(1000).append(text);
+      reference.draw(attributes);
+      return bitmap.calculate_hash();
+    };
+
+    var::String text;
+    for (u32 i = 0; i < 12; i++) {
+      text += var::NumberString(i, "line %d\n");
+    }
+    text += "end";
+
+    Layout &layout = Layout::create("textAreaLayout");
+    TextArea &area = TextArea::create("textArea");
+    area.set_text_height(1000).append(text);
+    layout.add_component(area);
+    context.controller.transition(layout);
+    context.controller.distribute_event(SystemEvent::periodic());
+    context.controller.distribute_event(SystemEvent::periodic());
+    TEST_ASSERT(area.scroll_total() > 0);
+    TEST_ASSERT(screen.calculate_hash() == draw_reference(text));
+
+    area.scroll_bottom().redraw();
+    context.controller.distribute_event(SystemEvent::periodic());
+
+    // removing all but one screen of lines scrolls to the top; every
+    // row is drawn again, including the rows below the text
+    area.remove(0, var::StringView("line 0\n").length() * 9);
+    context.controller.distribute_event(SystemEvent::periodic());
+    const var::StringView remaining = "line 9\nline 10\nline 11\nend";
+    TEST_ASSERT(area.text_buffer().to_string() == remaining);
+    TEST_ASSERT(area.scroll() == 0);
+    TEST_ASSERT(context.device.window().y() < 8);
+    TEST_ASSERT(context.device.window().height() > 4 * 8);
+    TEST_ASSERT(screen.calculate_hash() == draw_reference(remaining));
+
+    // an edit that keeps the number of lines draws only its line
+    area.insert(0, ">");
+    context.controller.distribute_event(SystemEvent::periodic());
+    TEST_ASSERT(context.device.window().height() == 8);
+    TEST_ASSERT(
+      screen.calculate_hash()
+      == draw_reference(">line 9\nline 10\nline 11\nend"));
+
+    return true;
+  }
+
+  bool display_device_case() {
+    using namespace ux;
+
+    sgfx::BitmapData bitmap(sgfx::Area(8, 8), sgfx::Bitmap::BitsPerPixel::x1);
+    bitmap.clear();
+    bitmap.set_pen(sgfx::Pen()).draw_pixel(sgfx::Point(3, 3));
+
+    {
+      FramebufferDisplayDevice device(
+        sgfx::Area(32, 16),
+        sgfx::Bitmap::BitsPerPixel::x1);
+      Display display(device);
+      TEST_ASSERT(display.bitmap().area() == sgfx::Area(32, 16));
+
+      // write the bottom right quarter of the bitmap
+      display.set_window(sgfx::Region(sgfx::Point(10, 2), sgfx::Area(4, 4)))
+        .write_bitmap(sgfx::Bitmap(bitmap).set_offset(sgfx::Point(2, 2)));
+      TEST_ASSERT(device.write_count() == 1);
+      TEST_ASSERT(device.write_size() == 2);
+      TEST_ASSERT(device.bitmap().get_pixel(sgfx::Point(11, 3)) != 0);
+      TEST_ASSERT(device.bitmap().get_pixel(sgfx::Point(10, 2)) == 0);
+
+      display.clear();
+      TEST_ASSERT(device.bitmap().get_pixel(sgfx::Point(11, 3)) == 0);
+    }
+
+    {
+      SimulatedDisplayDevice device(
+        SimulatedDisplayDevice::Construct()
+          .set_area(sgfx::Area(32, 16))
+          .set_bits_per_pixel(sgfx::Bitmap::BitsPerPixel::x16)
+          .set_bus_frequency(8000000)
+          .set_command_size(0));
+      Display display(device);
+
+      // 32 x 16 pixels at 2 bytes each take 1024us at 1MB/s
+      device.reset_statistics();
+      display.set_window(sgfx::Region(sgfx::Point(), sgfx::Area(32, 16)))
+        .write_bitmap(sgfx::BitmapData(
+          sgfx::Area(32, 16),
+          sgfx::Bitmap::BitsPerPixel::x16));
+      TEST_ASSERT(device.bus_time().microseconds() == 1024);
+
+      display.refresh();
+      TEST_ASSERT(display.is_busy());
+      display.wait(1_milliseconds);
+      TEST_ASSERT(display.is_busy() == false);
+    }
+
+    return true;
+  }
+
+  bool compositor_case() {
+    using namespace ux;
+
+    FramebufferDisplayDevice device(
+      sgfx::Area(64, 32),
+      sgfx::Bitmap::BitsPerPixel::x1);
+    Display display(device);
+    Compositor compositor(
+      display.bitmap().area(),
+      display.bitmap().bits_per_pixel());
+    compositor.set_transaction_cost(16);
+    display.set_compositor(&compositor);
+
+    sgfx::BitmapData bitmap(sgfx::Area(8, 8), sgfx::Bitmap::BitsPerPixel::x1);
+    bitmap.clear();
+    bitmap.set_pen(sgfx::Pen()).draw_pixel(sgfx::Point(1, 1));
+
+    // neighbors are sent as one window
+    device.reset_statistics();
+    display.begin_frame();
+    display.set_window(sgfx::Region(sgfx::Point(0, 0), sgfx::Area(8, 8)))
+      .write_bitmap(bitmap);
+    display.set_window(sgfx::Region(sgfx::Point(8, 0), sgfx::Area(8, 8)))
+      .write_bitmap(bitmap);
+    TEST_ASSERT(device.write_count() == 0);
+    display.end_frame();
+    TEST_ASSERT(device.write_count() == 1);
+    TEST_ASSERT(device.write_size() == 16);
+    TEST_ASSERT(device.bitmap().get_pixel(sgfx::Point(9, 1)) != 0);
+
+    // distant regions are sent separately
+    device.reset_statistics();
+    display.begin_frame();
+    display.set_window(sgfx::Region(sgfx::Point(0, 16), sgfx::Area(8, 8)))
+      .write_bitmap(bitmap);
+    display.set_window(sgfx::Region(sgfx::Point(56, 24), sgfx::Area(8, 8)))
+      .write_bitmap(bitmap);
+    display.end_frame();
+    TEST_ASSERT(device.write_count() == 2);
+    TEST_ASSERT(device.bitmap().get_pixel(sgfx::Point(57, 25)) != 0);
+
+    // writing a window again only sends the pixels that changed
+    device.reset_statistics();
+    bitmap.draw_pixel(sgfx::Point(5, 6));
+    display.begin_frame();
+    display.set_window(sgfx::Region(sgfx::Point(8, 0), sgfx::Area(8, 8)))
+      .write_bitmap(bitmap);
+    display.set_window(sgfx::Region(sgfx::Point(56, 24), sgfx::Area(8, 8)))
+      .write_bitmap(bitmap);
+    display.end_frame();
+    TEST_ASSERT(device.write_count() == 2);
+    TEST_ASSERT(device.write_size() == 2);
+    TEST_ASSERT(device.bitmap().get_pixel(sgfx::Point(13, 6)) != 0);
+    TEST_ASSERT(device.bitmap().get_pixel(sgfx::Point(61, 30)) != 0);
+
+    // nothing is sent if the pixels are the same
+    device.reset_statistics();
+    display.begin_frame();
+    display.set_window(sgfx::Region(sgfx::Point(8, 0), sgfx::Area(8, 8)))
+      .write_bitmap(bitmap);
+    display.end_frame();
+    TEST_ASSERT(device.write_count() == 0);
+
+    {
+      // writes are sent with the palette that was set when they were made
+      PaletteRecordingDevice palette_device(
+        sgfx::Area(64, 32),
+        sgfx::Bitmap::BitsPerPixel::x1);
+      Display palette_display(palette_device);
+      Compositor palette_compositor(
+        palette_display.bitmap().area(),
+        palette_display.bitmap().bits_per_pixel());
+      palette_compositor.set_transaction_cost(16);
+      palette_display.set_compositor(&palette_compositor);
+
+      sgfx::Palette first;
+      first.set_pixel_format(sgfx::Palette::PixelFormat::rgb565)
+        .set_color_count(sgfx::Palette::ColorCount::x1bpp);
+      first.colors().at(1) = 0x1111;
+      sgfx::Palette second = first;
+      second.colors().at(1) = 0x2222;
+      auto device_color = [&]() {
+        const display_palette_t palette = palette_device.get_palette();
+        return static_cast<const sg_color_t *>(palette.colors)[1];
+      };
+
+      palette_display.set_palette(first);
+      TEST_ASSERT(device_color() == 0x1111);
+
+      // neighbors with different palettes are not merged
+      palette_display.begin_frame();
+      palette_display
+        .set_window(sgfx::Region(sgfx::Point(0, 0), sgfx::Area(8, 8)))
+        .write_bitmap(bitmap);
+      palette_display.set_palette(second);
+      TEST_ASSERT(device_color() == 0x1111);
+      palette_display
+        .set_window(sgfx::Region(sgfx::Point(8, 0), sgfx::Area(8, 8)))
+        .write_bitmap(bitmap);
+      palette_display.end_frame();
+      TEST_ASSERT(palette_device.write_count() == 2);
+      TEST_ASSERT(palette_device.write_color_list.count() == 2);
+      TEST_ASSERT(palette_device.write_color_list.at(0) == 0x1111);
+      TEST_ASSERT(palette_device.write_color_list.at(1) == 0x2222);
+      TEST_ASSERT(device_color() == 0x2222);
+
+      // a palette set without writes is sent when the frame ends
+      palette_display.begin_frame();
+      palette_display.set_palette(first);
+      TEST_ASSERT(device_color() == 0x2222);
+      palette_display.end_frame();
+      TEST_ASSERT(device_color() == 0x1111);
+
+      // windows written with another palette are sent again in full
+      palette_device.reset_statistics();
+      palette_device.write_color_list.clear();
+      palette_display.begin_frame();
+      palette_display
+        .set_window(sgfx::Region(sgfx::Point(8, 0), sgfx::Area(8, 8)))
+        .write_bitmap(bitmap);
+      palette_display.end_frame();
+      TEST_ASSERT(palette_device.write_count() == 1);
+      TEST_ASSERT(palette_device.write_size() == 8);
+      TEST_ASSERT(palette_device.write_color_list.at(0) == 0x1111);
+
+      // the palette in effect is kept across frames so setting it
+      // again does not send the window again
+      palette_device.reset_statistics();
+      palette_display.begin_frame();
+      palette_display.set_palette(first)
+        .set_window(sgfx::Region(sgfx::Point(8, 0), sgfx::Area(8, 8)))
+        .write_bitmap(bitmap);
+      palette_display.end_frame();
+      TEST_ASSERT(palette_device.write_count() == 0);
+    }
+
+    {
+      // components set their theme palette before each write so
+      // drawing one again only sends the pixels that changed
+      ComponentContext &context = component_context();
+      Compositor component_compositor(
+        context.display.bitmap().area(),
+        context.display.bitmap().bits_per_pixel());
+      context.display.set_compositor(&component_compositor);
+
+      Layout &layout = Layout::create("compositorLayout");
+      TextArea &area = TextArea::create("compositorArea");
+      area.set_text_height(1000).append("first\nsecond");
+      layout.add_component(area);
+      context.controller.transition(layout);
+      context.controller.distribute_event(SystemEvent::periodic());
+      context.controller.distribute_event(SystemEvent::periodic());
+
+      // the line is written again but only the part around the new
+      // glyph is sent
+      context.device.reset_statistics();
+      area.append("!");
+      context.controller.distribute_event(SystemEvent::periodic());
+      const sgfx::Region &window = component_compositor.window();
+      TEST_ASSERT(window.width() > 8 * 8);
+      TEST_ASSERT(context.device.write_count() == 1);
+      TEST_ASSERT(
+        context.device.write_size() * 2
+        < u32(window.width()) * window.height() * 2 / 8);
+
+      context.display.set_compositor(nullptr);
+    }
+
+    return true;
+  }
+
+  bool display_state_case() {
+    using namespace ux;
+
+    FramebufferDisplayDevice device(
+      sgfx::Area(64, 32),
+      sgfx::Bitmap::BitsPerPixel::x1);
+    Display display(device);
+
+    sgfx::Palette palette;
+    palette.set_pixel_format(sgfx::Palette::PixelFormat::rgb565)
+      .set_color_count(sgfx::Palette::ColorCount::x1bpp);
+    palette.colors().at(1) = 0xffff;
+
+    // repeated requests are not sent to the device
+    device.reset_statistics();
+    const sgfx::Region window(sgfx::Point(4, 4), sgfx::Area(8, 8));
+    for (u32 i = 0; i < 4; i++) {
+      display.set_window(window)
+        .set_mode(Display::Mode::palette)
+        .set_palette(palette);
+    }
+    TEST_ASSERT(device.attribute_count() == 2);
+    TEST_ASSERT(display.skipped_window_count() == 3);
+    TEST_ASSERT(display.skipped_mode_count() == 3);
+    TEST_ASSERT(display.skipped_palette_count() == 3);
+
+    // changes are sent
+    palette.colors().at(1) = 0x0000;
+    display.set_palette(palette).set_window(sgfx::Region());
+    const display_palette_t device_palette = device.get_palette();
+    TEST_ASSERT(device_palette.count == 2);
+    TEST_ASSERT(static_cast<const sg_color_t *>(device_palette.colors)[1] == 0);
+    TEST_ASSERT(device.attribute_count() == 3);
+
+    return true;
+  }
+
+  // checks Font::measure() against a search of all the kerning pairs
+  static bool is_kerning_measured(
+    const ux::sgfx::Font &font,
+    const var::Vector<sg_font_kerning_pair_t> &pairs) {
+    const var::StringView string = "AVATAR Wo.To ~~ Ta.e";
+    sg_int_t advance_list[32];
+    font.measure(string, advance_list, string.length());
+
+    sg_int_t x = 0;
+    for (size_t i = 0; i < string.length(); i++) {
+      x += font.get_advance(u8(string.at(i)));
+      if (font.is_kerning_enabled() && (i + 1 < string.length())) {
+        for (const sg_font_kerning_pair_t &pair : pairs) {
+          if (
+            (pair.unicode_first == u8(string.at(i)))
+            && (pair.unicode_second == u8(string.at(i + 1)))) {
+            x -= pair.horizontal_kerning;
+          }
+        }
+      }
+      if (advance_list[i] != x) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static u8 get_unicode_advance(u32 unicode) { return 3 + unicode % 7; }
+
+  // a 1bpp unicode font with a character for each code point in
+  // range_list; the advance depends on the code point
+  static var::Data create_unicode_font_data(
+    const var::Vector<sg_font_unicode_range_t> &range_list) {
+    u32 character_count = 0;
+    for (const sg_font_unicode_range_t &range : range_list) {
+      character_count += range.count;
+    }
+    const u32 canvas_size = sizeof(sg_bmap_data_t) * 8;
+    const u32 range_size
+      = range_list.count() * sizeof(sg_font_unicode_range_t);
+
+    sg_font_header_t header = {};
+    header.max_word_width = 1;
+    header.max_height = 8;
+    header.bits_per_pixel = 1;
+    header.version = SG_FONT_VERSION_FLAG_IS_UNICODE;
+    header.size = sizeof(sg_font_header_t) + sizeof(sg_font_unicode_header_t)
+                  + range_size + character_count * sizeof(sg_font_char_t);
+    header.canvas_width = 32;
+    header.canvas_height = 8;
+
+    sg_font_unicode_header_t unicode_header = {};
+    unicode_header.character_count = character_count;
+    unicode_header.range_count = range_list.count();
+
+    var::Data result(header.size + canvas_size);
+    u8 *data = result.data_u8();
+    memcpy(data, &header, sizeof(header));
+    data += sizeof(header);
+    memcpy(data, &unicode_header, sizeof(unicode_header));
+    data += sizeof(unicode_header);
+    memcpy(data, range_list.data(), range_size);
+    data += range_size;
+    for (const sg_font_unicode_range_t &range : range_list) {
+      for (u32 i = 0; i < range.count; i++) {
+        sg_font_char_t character = {};
+        character.id = range.first + i;
+        character.advance_x = get_unicode_advance(range.first + i);
+        character.width = character.advance_x - 1;
+        character.height = 8;
+        memcpy(data, &character, sizeof(character));
+        data += sizeof(character);
+      }
+    }
+    memset(data, 0xff, canvas_size);
+    return result;
+  }
+
+  // the second icon is wider than the first
+  static void
+  write_icon_font(fs::DataFile &file, const char *a, const char *b) {
+    sg_font_icon_header_t header = {};
+    header.icon_count = 2;
+    header.size = sizeof(header) + header.icon_count * sizeof(sg_font_icon_t);
+    header.max_width = 8;
+    header.max_height = 8;
+    header.bits_per_pixel = 1;
+    header.canvas_width = 16;
+    header.canvas_height = 8;
+    file.seek(0).write(var::View(header));
+
+    const char *name_list[2] = {a, b};
+    for (u32 i = 0; i < header.icon_count; i++) {
+      sg_font_icon_t icon = {};
+      icon.canvas_x = i * 8;
+      icon.width = 4 + i * 2;
+      icon.height = 8;
+      strncpy(icon.name, name_list[i], SG_FONT_ICON_MAX_NAME_LENGTH);
+      file.write(var::View(icon));
+    }
+  }
+
+  // a font where each printable character is a 4x8 block; fonts with
+  // more than 1 bit per pixel are coverage fonts with 50% coverage
+  static var::Data create_font_data(
+    const var::Vector<sg_font_kerning_pair_t> &kerning_pairs
+    = var::Vector<sg_font_kerning_pair_t>(),
+    u8 bits_per_pixel = 1) {
+    const u32 character_count = '~' - ' ';
+    const u32 canvas_size = sizeof(sg_bmap_data_t) * 8 * bits_per_pixel;
+    const u32 kerning_size
+      = kerning_pairs.count() * sizeof(sg_font_kerning_pair_t);
+
+    sg_font_header_t header = {};
+    header.character_count = character_count;
+    header.max_word_width = 1;
+    header.max_height = 8;
+    header.bits_per_pixel = bits_per_pixel;
+    header.version = bits_per_pixel > 1 ? SG_FONT_VERSION_FLAG_IS_COVERAGE : 0;
+    header.kerning_pair_count = kerning_pairs.count();
+    header.size = sizeof(sg_font_header_t) + kerning_size
+                  + character_count * sizeof(sg_font_char_t);
+    header.canvas_width = 32;
+    header.canvas_height = 8;
+
+    var::Data result(header.size + canvas_size);
+    u8 *data = result.data_u8();
+    memcpy(data, &header, sizeof(header));
+    if (kerning_size) {
+      memcpy(data + sizeof(header), kerning_pairs.data(), kerning_size);
+    }
+    for (u32 i = 0; i < character_count; i++) {
+      sg_font_char_t character = {};
+      character.id = ' ' + 1 + i;
+      character.width = 4;
+      character.height = 8;
+      character.advance_x = 5;
+      memcpy(
+        data + sizeof(header) + kerning_size + i * sizeof(character),
+        &character,
+        sizeof(character));
+    }
+    memset(data + header.size, bits_per_pixel > 1 ? 0x77 : 0xff, canvas_size);
+    return result;
+  }
+
+  class ComponentModel : public ux::Model {
+  private:
+    EntryList m_entry_list;
+
+    Entry *find(const var::StringView key) {
+      for (Entry &entry : m_entry_list) {
+        if (entry.name().string_view() == key) {
+          return &entry;
+        }
+      }
+      return nullptr;
+    }
+
+    void
+    interface_set(const var::StringView key, const var::StringView value)
+      override {
+      Entry *entry = find(key);
+      if (entry == nullptr) {
+        m_entry_list.push_back(Entry().set_name(key));
+        entry = &m_entry_list.back();
+      }
+      entry->set_value(var::String(value));
+    }
+
+    var::StringView interface_get(const var::StringView key) const override {
+      for (const Entry &entry : m_entry_list) {
+        if (entry.name().string_view() == key) {
+          return entry.value().string_view();
+        }
+      }
+      return var::StringView();
+    }
+
+    const var::Array<var::StringView, 2>
+    interface_at(size_t offset) const override {
+      var::Array<var::StringView, 2> result;
+      if (offset < m_entry_list.count()) {
+        result.at(0) = m_entry_list.at(offset).name().string_view();
+        result.at(1) = m_entry_list.at(offset).value().string_view();
+      }
+      return result;
+    }
+
+    void interface_discard(const var::StringView key) override {
+      for (size_t i = 0; i < m_entry_list.count(); i++) {
+        if (m_entry_list.at(i).name().string_view() == key) {
+          m_entry_list.remove(i);
+          return;
+        }
+      }
+    }
+  };
+
+  class ComponentEventLoop : public ux::EventLoop {
+  public:
+    using EventLoop::EventLoop;
+    void process_events() override {}
+  };
+
+  // components share one event loop for their theme, model, and
+  // display; the theme's primary font "sans" is in an asset pack
+  class ComponentContext {
+  public:
+    ComponentContext()
+      : device(ux::sgfx::Area(128, 64), ux::sgfx::Bitmap::BitsPerPixel::x2),
+        display(device), theme(theme_file), controller(event_loop),
+        event_loop(controller, model, display, theme) {
+      const var::StringView theme_path = "component_theme.dat";
+      theme.create(
+        theme_path,
+        fs::File::IsOverwrite::yes,
+        ux::sgfx::Bitmap::BitsPerPixel::x2,
+        ux::sgfx::Palette::PixelFormat::rgb888);
+      theme.set_primary_font_name("sans");
+
+      const var::Data font_data = create_font_data();
+      var::Vector<ux::fmt::AssetPack::Item> item_list;
+      item_list.push_back(ux::fmt::AssetPack::Item()
+                            .set_type(ux::fmt::AssetPack::Type::font)
+                            .set_name("sans")
+                            .set_style(ux::sgfx::Font::Style::regular)
+                            .set_point_size(8)
+                            .set_data(font_data));
+      const var::StringView pack_path = "component_assets.uxpack";
+      ux::fmt::AssetPack::save(
+        fs::File(fs::File::IsOverwrite::yes, pack_path),
+        item_list);
+      ux::Assets::load_pack(pack_path);
+
+      // the open files are not needed by name
+      fs::FileSystem().remove(pack_path).remove(theme_path);
+      ux::Component::set_event_loop(event_loop);
+    }
+
+    ComponentModel model;
+    ux::FramebufferDisplayDevice device;
+    ux::Display display;
+    fs::File theme_file;
+    ux::sgfx::Theme theme;
+    ux::Controller controller;
+    ComponentEventLoop event_loop;
+  };
+
+  static ComponentContext &component_context() {
+    static ComponentContext context;
+    return context;
+  }
+
+  // records color 1 of the device palette when each window is written
+  class PaletteRecordingDevice : public ux::FramebufferDisplayDevice {
+  public:
+    using FramebufferDisplayDevice::FramebufferDisplayDevice;
+    var::Vector<sg_color_t> write_color_list;
+
+  protected:
+    void interface_write_bitmap(const ux::sgfx::Bitmap &bitmap) override {
+      const display_palette_t palette = interface_get_palette();
+      write_color_list.push_back(
+        palette.count > 1 ? static_cast<const sg_color_t *>(palette.colors)[1]
+                          : 0);
+      FramebufferDisplayDevice::interface_write_bitmap(bitmap);
+    }
+  };
 };
@@ -1,6 +1,7 @@
 ﻿// Copyright 2016-2021 Tyler Gilbert and Stratify Labs, Inc; see LICENSE.md
 
 #include <signal.h>
+#include <cstdlib>
 
 #include "UnitTest.hpp"
 
@@ -9,6 +10,22 @@
 
 void segfault(int a) { API_ASSERT(false); }
 
+// count allocations so tests can check for steady-state allocations
+void *operator new(size_t size) {
+  AllocationCounter::increment();
+  void *result = malloc(size ? size : 1);
+  if (result == nullptr) {
+    abort();
+  }
+  return result;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *pointer) noexcept { free(pointer); }
+void operator delete[](void *pointer) noexcept { free(pointer); }
+void operator delete(void *pointer, size_t) noexcept { free(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { free(pointer); }
+
 int main(int argc, char *argv[]) {
   sys::Cli cli(argc, argv);
 